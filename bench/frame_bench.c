@@ -0,0 +1,185 @@
+/**
+ * frame_bench.c - Headless frame benchmark (make bench)
+ *
+ * Renders every registered room through the real render path into an
+ * offscreen surface with SDL's software renderer; no window or display
+ * is needed. SDL calls (and the pixels they write) are counted by wrapping
+ * the renderer entry points at link time (-Wl,--wrap, see the Makefile).
+ *
+ * Usage: frame-bench [frames]
+ */
+
+#include "game.h"
+#include "atlas.h"
+#include "render.h"
+#include "room.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define DEFAULT_FRAMES 500
+
+// ----------------------------------------------------------------------------
+// SDL call counting
+// ----------------------------------------------------------------------------
+
+static uint64_t sdl_calls = 0;
+static uint64_t pixels_written = 0;
+
+static uint64_t rect_area(const SDL_Rect *rect) {
+    if (!rect) return (uint64_t)WINDOW_WIDTH * WINDOW_HEIGHT;
+    return (uint64_t)rect->w * rect->h;
+}
+
+int __real_SDL_RenderCopy(SDL_Renderer *r, SDL_Texture *t, const SDL_Rect *src, const SDL_Rect *dst);
+int __wrap_SDL_RenderCopy(SDL_Renderer *r, SDL_Texture *t, const SDL_Rect *src, const SDL_Rect *dst) {
+    sdl_calls++;
+    pixels_written += rect_area(dst);
+    return __real_SDL_RenderCopy(r, t, src, dst);
+}
+
+int __real_SDL_RenderFillRect(SDL_Renderer *r, const SDL_Rect *rect);
+int __wrap_SDL_RenderFillRect(SDL_Renderer *r, const SDL_Rect *rect) {
+    sdl_calls++;
+    pixels_written += rect_area(rect);
+    return __real_SDL_RenderFillRect(r, rect);
+}
+
+int __real_SDL_RenderFillRects(SDL_Renderer *r, const SDL_Rect *rects, int count);
+int __wrap_SDL_RenderFillRects(SDL_Renderer *r, const SDL_Rect *rects, int count) {
+    sdl_calls++;
+    for (int i = 0; i < count; i++) pixels_written += rect_area(&rects[i]);
+    return __real_SDL_RenderFillRects(r, rects, count);
+}
+
+// Batched copies from the command buffer: axis-aligned quads of 4 vertices
+int __real_SDL_RenderGeometry(SDL_Renderer *r, SDL_Texture *t, const SDL_Vertex *v, int nv,
+                              const int *indices, int ni);
+int __wrap_SDL_RenderGeometry(SDL_Renderer *r, SDL_Texture *t, const SDL_Vertex *v, int nv,
+                              const int *indices, int ni) {
+    sdl_calls++;
+    for (int i = 0; i + 3 < nv; i += 4) {
+        float w = v[i + 2].position.x - v[i].position.x;
+        float h = v[i + 2].position.y - v[i].position.y;
+        pixels_written += (uint64_t)(w * h);
+    }
+    return __real_SDL_RenderGeometry(r, t, v, nv, indices, ni);
+}
+
+int __real_SDL_RenderDrawPoint(SDL_Renderer *r, int x, int y);
+int __wrap_SDL_RenderDrawPoint(SDL_Renderer *r, int x, int y) {
+    sdl_calls++;
+    pixels_written++;
+    return __real_SDL_RenderDrawPoint(r, x, y);
+}
+
+int __real_SDL_RenderClear(SDL_Renderer *r);
+int __wrap_SDL_RenderClear(SDL_Renderer *r) {
+    sdl_calls++;
+    pixels_written += rect_area(NULL);
+    return __real_SDL_RenderClear(r);
+}
+
+int __real_SDL_SetRenderDrawColor(SDL_Renderer *r, Uint8 red, Uint8 g, Uint8 b, Uint8 a);
+int __wrap_SDL_SetRenderDrawColor(SDL_Renderer *r, Uint8 red, Uint8 g, Uint8 b, Uint8 a) {
+    sdl_calls++;
+    return __real_SDL_SetRenderDrawColor(r, red, g, b, a);
+}
+
+int __real_SDL_SetRenderTarget(SDL_Renderer *r, SDL_Texture *t);
+int __wrap_SDL_SetRenderTarget(SDL_Renderer *r, SDL_Texture *t) {
+    sdl_calls++;
+    return __real_SDL_SetRenderTarget(r, t);
+}
+
+int __real_SDL_UpdateTexture(SDL_Texture *t, const SDL_Rect *rect, const void *pixels, int pitch);
+int __wrap_SDL_UpdateTexture(SDL_Texture *t, const SDL_Rect *rect, const void *pixels, int pitch) {
+    sdl_calls++;
+    pixels_written += rect_area(rect);
+    return __real_SDL_UpdateTexture(t, rect, pixels, pitch);
+}
+
+void __real_SDL_RenderPresent(SDL_Renderer *r);
+void __wrap_SDL_RenderPresent(SDL_Renderer *r) {
+    sdl_calls++;
+    __real_SDL_RenderPresent(r);
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark
+// ----------------------------------------------------------------------------
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Render `frames` frames of the current room. A cold run drops the room
+// layer every frame so each one pays for a full redraw.
+static void bench_run(const char *label, int frames, bool cold, uint64_t *samples) {
+    double ns_per_tick = 1e9 / (double)SDL_GetPerformanceFrequency();
+    uint64_t calls_before = sdl_calls;
+    uint64_t pixels_before = pixels_written;
+    uint64_t total_ns = 0;
+
+    for (int i = 0; i < frames; i++) {
+        if (cold) render_invalidate();
+        uint64_t start = SDL_GetPerformanceCounter();
+        render_frame();
+        render_present();
+        samples[i] = (uint64_t)((SDL_GetPerformanceCounter() - start) * ns_per_tick);
+        total_ns += samples[i];
+    }
+
+    qsort(samples, frames, sizeof(uint64_t), compare_u64);
+    printf("%-12s %-5s %10llu %10llu %10llu %10.1f %12.1f\n",
+           g_game.current_room->name, label,
+           (unsigned long long)(total_ns / frames),
+           (unsigned long long)samples[frames / 2],
+           (unsigned long long)samples[(frames * 99) / 100],
+           (double)(sdl_calls - calls_before) / frames,
+           (double)(pixels_written - pixels_before) / frames);
+}
+
+int main(int argc, char *argv[]) {
+    int frames = argc > 1 ? atoi(argv[1]) : DEFAULT_FRAMES;
+    if (frames <= 0) frames = DEFAULT_FRAMES;
+
+    if (SDL_Init(0) < 0) {
+        fprintf(stderr, "SDL_Init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(
+        0, WINDOW_WIDTH, WINDOW_HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+    g_game.renderer = surface ? SDL_CreateSoftwareRenderer(surface) : NULL;
+    if (!g_game.renderer) {
+        fprintf(stderr, "software renderer failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    rooms_init();
+    if (!atlas_init(g_game.renderer) || !render_init()) {
+        return 1;
+    }
+
+    uint64_t *samples = malloc(sizeof(uint64_t) * frames);
+    if (!samples) return 1;
+
+    printf("%d frames per run, %dx%d software renderer\n\n", frames, WINDOW_WIDTH, WINDOW_HEIGHT);
+    printf("%-12s %-5s %10s %10s %10s %10s %12s\n",
+           "room", "run", "ns/frame", "p50", "p99", "calls/f", "pixels/f");
+
+    for (int i = 0; i < room_count(); i++) {
+        g_game.current_room = room_get(i);
+        bench_run("cold", frames, true, samples);
+        bench_run("warm", frames, false, samples);
+    }
+
+    free(samples);
+    render_shutdown();
+    atlas_shutdown();
+    SDL_DestroyRenderer(g_game.renderer);
+    SDL_FreeSurface(surface);
+    SDL_Quit();
+    return 0;
+}
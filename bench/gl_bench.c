@@ -0,0 +1,280 @@
+/**
+ * gl_bench.c - Headless check and benchmark of the GL tilemap (make gl-bench)
+ *
+ * Creates a GLES 3 context with EGL on Mesa's surfaceless platform (the
+ * llvmpipe software rasterizer is enough), renders every registered room
+ * through gltiles.c into an offscreen framebuffer, and compares the pixels
+ * with a CPU reference drawn the way the other backends draw: tiles, then
+ * the player, then the furniture cells in front of the player. A frame
+ * half-way through a room cross-fade is checked too. Exits non-zero on any
+ * mismatch, so it doubles as a test.
+ *
+ * Usage: gl-bench [frames]
+ */
+
+#include "game.h"
+#include "atlas.h"
+#include "gltiles.h"
+#include "room.h"
+#include "stats.h"
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES3/gl3.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_FRAMES 300
+
+// ----------------------------------------------------------------------------
+// Context
+// ----------------------------------------------------------------------------
+
+static EGLDisplay display = EGL_NO_DISPLAY;
+static EGLContext context = EGL_NO_CONTEXT;
+static GLuint framebuffer = 0, color_buffer = 0;
+
+static bool context_init(void) {
+    PFNEGLGETPLATFORMDISPLAYEXTPROC get_display =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (get_display) display = get_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, NULL, NULL)) {
+        fprintf(stderr, "gl-bench: no surfaceless EGL display (Mesa needed)\n");
+        return false;
+    }
+    eglBindAPI(EGL_OPENGL_ES_API);
+    const EGLint attributes[] = {EGL_CONTEXT_MAJOR_VERSION, 3, EGL_NONE};
+    context = eglCreateContext(display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, attributes);
+    if (context == EGL_NO_CONTEXT ||
+        !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+        fprintf(stderr, "gl-bench: no GLES 3 context (EGL error 0x%x)\n", eglGetError());
+        return false;
+    }
+
+    glGenRenderbuffers(1, &color_buffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, color_buffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, WINDOW_WIDTH, WINDOW_HEIGHT);
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color_buffer);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        fprintf(stderr, "gl-bench: offscreen framebuffer incomplete\n");
+        return false;
+    }
+    printf("%s, %s\n", glGetString(GL_RENDERER), glGetString(GL_VERSION));
+    return true;
+}
+
+static void context_shutdown(void) {
+    if (framebuffer) glDeleteFramebuffers(1, &framebuffer);
+    if (color_buffer) glDeleteRenderbuffers(1, &color_buffer);
+    if (context != EGL_NO_CONTEXT) eglDestroyContext(display, context);
+    if (display != EGL_NO_DISPLAY) eglTerminate(display);
+}
+
+// ----------------------------------------------------------------------------
+// Reference
+// ----------------------------------------------------------------------------
+
+typedef struct {
+    const Room *room;
+    SDL_Point camera, player;
+} View;
+
+static uint8_t reference[WINDOW_HEIGHT][WINDOW_WIDTH];
+static uint8_t pixels[WINDOW_HEIGHT][WINDOW_WIDTH][4];
+
+// Same framing as render.c: centred on the player, clamped to the room
+static int camera_axis(int target, int room_px, int screen_px) {
+    if (room_px <= screen_px) return (room_px - screen_px) / 2;
+    int c = target - screen_px / 2;
+    if (c < 0) return 0;
+    return c > room_px - screen_px ? room_px - screen_px : c;
+}
+
+static View view_at(const Room *room, int px, int py) {
+    SDL_Point camera = {
+        camera_axis(px + PLAYER_SIZE / 2, room->width * TILE_SIZE, WINDOW_WIDTH),
+        camera_axis(py + PLAYER_SIZE / 2, room->height * TILE_SIZE, WINDOW_HEIGHT)};
+    return (View){room, camera, {px, py}};
+}
+
+static void put_tile(const View *v, int x, int y, bool clip_to_player) {
+    const uint8_t *bitmap = atlas_bitmap((TileType)room_tile(v->room, x, y)->type,
+                                         room_tile_variant(v->room, x, y));
+    for (int row = 0; row < TILE_SIZE; row++) {
+        for (int col = 0; col < TILE_SIZE; col++) {
+            int wx = x * TILE_SIZE + col, wy = y * TILE_SIZE + row;
+            int sx = wx - v->camera.x, sy = wy - v->camera.y;
+            if (sx < 0 || sy < 0 || sx >= WINDOW_WIDTH || sy >= WINDOW_HEIGHT) continue;
+            if (clip_to_player && (wx < v->player.x || wy < v->player.y ||
+                                   wx >= v->player.x + PLAYER_SIZE ||
+                                   wy >= v->player.y + PLAYER_SIZE)) continue;
+            reference[sy][sx] = bitmap[row * TILE_SIZE + col];
+        }
+    }
+}
+
+static void draw_reference(const View *v) {
+    memset(reference, 0, sizeof(reference));
+    const Room *room = v->room;
+    for (int y = 0; y < room->height; y++) {
+        for (int x = 0; x < room->width; x++) put_tile(v, x, y, false);
+    }
+
+    const uint8_t *sprite = atlas_player_bitmap();
+    for (int y = 0; y < PLAYER_SIZE; y++) {
+        for (int x = 0; x < PLAYER_SIZE; x++) {
+            int sx = v->player.x + x - v->camera.x, sy = v->player.y + y - v->camera.y;
+            uint8_t index = sprite[y * PLAYER_SIZE + x];
+            if (index == ATLAS_TRANSPARENT || sx < 0 || sy < 0 ||
+                sx >= WINDOW_WIDTH || sy >= WINDOW_HEIGHT) continue;
+            reference[sy][sx] = index;
+        }
+    }
+
+    // Furniture cells in front of the player go back over it
+    int baseline = v->player.y + PLAYER_SIZE;
+    for (int y = v->player.y / TILE_SIZE; y <= (baseline - 1) / TILE_SIZE; y++) {
+        for (int x = v->player.x / TILE_SIZE; x <= (v->player.x + PLAYER_SIZE - 1) / TILE_SIZE; x++) {
+            if (!room_contains(room, x, y)) continue;
+            const Tile *tile = room_tile(room, x, y);
+            if (!tile_is_sprite((TileType)tile->type)) continue;
+            const RoomObject *obj = &room->objects[tile->variant];
+            if ((obj->y + obj->h) * TILE_SIZE > baseline) put_tile(v, x, y, true);
+        }
+    }
+}
+
+// Pixels off by more than tolerance per channel from the reference, or
+// from a mix of it with a second one (mix: weight of the second)
+static int compare(const uint8_t (*other)[WINDOW_WIDTH], float mix, int tolerance) {
+    int colors;
+    const Color *palette = atlas_palette(&colors);
+    glReadPixels(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    int bad = 0;
+    for (int y = 0; y < WINDOW_HEIGHT; y++) {
+        const uint8_t (*row)[4] = pixels[WINDOW_HEIGHT - 1 - y];  // GL rows go up
+        for (int x = 0; x < WINDOW_WIDTH; x++) {
+            Color a = palette[reference[y][x]];
+            Color b = other ? palette[other[y][x]] : a;
+            int want[3] = {
+                (int)(a.r + (b.r - a.r) * mix + 0.5f), (int)(a.g + (b.g - a.g) * mix + 0.5f),
+                (int)(a.b + (b.b - a.b) * mix + 0.5f)};
+            for (int c = 0; c < 3; c++) {
+                if (abs(row[x][c] - want[c]) > tolerance) {
+                    bad++;
+                    break;
+                }
+            }
+        }
+    }
+    return bad;
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark
+// ----------------------------------------------------------------------------
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// Player positions covering the room: a diagonal sweep, plus the player
+// standing just behind the first piece of furniture
+static SDL_Point path_point(const Room *room, int i, int frames) {
+    int w = room->width * TILE_SIZE - PLAYER_SIZE, h = room->height * TILE_SIZE - PLAYER_SIZE;
+    return (SDL_Point){(int)((int64_t)w * i / frames), (int)((int64_t)h * i / frames)};
+}
+
+static SDL_Point behind_furniture(const Room *room) {
+    for (int i = 0; i < room->object_count; i++) {
+        const RoomObject *obj = &room->objects[i];
+        if (!tile_is_sprite((TileType)obj->type)) continue;
+        return (SDL_Point){obj->x * TILE_SIZE, (obj->y + obj->h) * TILE_SIZE - PLAYER_SIZE - 4};
+    }
+    return (SDL_Point){0, 0};
+}
+
+static int check_view(const View *v) {
+    gl_tiles_draw(v->room, v->camera, &v->player, 0.0f);
+    draw_reference(v);
+    return compare(NULL, 0.0f, 0);
+}
+
+int main(int argc, char *argv[]) {
+    int frames = argc > 1 ? atoi(argv[1]) : DEFAULT_FRAMES;
+    if (frames <= 0) frames = DEFAULT_FRAMES;
+
+    rooms_init();
+    if (!context_init() || !atlas_init(NULL) || !gl_tiles_init()) {
+        context_shutdown();
+        return 1;
+    }
+
+    printf("%d frames per room, %dx%d, one draw call each\n\n", frames, WINDOW_WIDTH, WINDOW_HEIGHT);
+    printf("%-12s %10s %10s %10s %10s\n", "room", "upload us", "ns/frame", "calls/f", "mismatch");
+
+    int failures = 0;
+    static uint8_t previous[WINDOW_HEIGHT][WINDOW_WIDTH];
+    const Room *previous_room = NULL;
+    for (int r = 0; r < room_count(); r++) {
+        Room *room = room_get(r);
+        if (!room) return 1;
+
+        // Cross-fade from the last room into this one, half-way
+        if (previous_room) gl_tiles_begin_fade();
+        uint64_t start = now_ns();
+        gl_tiles_upload(room, (TileRect){0, 0, room->width, room->height});
+        glFinish();
+        uint64_t upload_ns = now_ns() - start;
+
+        int bad = 0;
+        View entry = view_at(room, room->entry_count ? room->entries[0].x * TILE_SIZE : 0,
+                             room->entry_count ? room->entries[0].y * TILE_SIZE : 0);
+        if (previous_room) {
+            gl_tiles_draw(room, entry.camera, &entry.player, 0.5f);
+            draw_reference(&entry);
+            bad += compare(previous, 0.5f, 1);
+        }
+
+        g_frame_stats = (FrameStats){0};
+        start = now_ns();
+        for (int i = 0; i < frames; i++) {
+            SDL_Point p = path_point(room, i, frames);
+            View v = view_at(room, p.x, p.y);
+            gl_tiles_draw(room, v.camera, &v.player, 0.0f);
+        }
+        glFinish();
+        uint64_t frame_ns = (now_ns() - start) / frames;
+        double calls = (double)g_frame_stats.draw_calls / frames;
+
+        for (int i = 0; i < 8; i++) {
+            SDL_Point p = path_point(room, i * frames / 8, frames);
+            View v = view_at(room, p.x, p.y);
+            bad += check_view(&v);
+        }
+        SDL_Point p = behind_furniture(room);
+        View behind = view_at(room, p.x, p.y);
+        bad += check_view(&behind);
+        bad += check_view(&entry);
+        memcpy(previous, reference, sizeof(previous));
+        previous_room = room;
+
+        printf("%-12s %10.1f %10llu %10.1f %10d\n", room->name, upload_ns / 1000.0,
+               (unsigned long long)frame_ns, calls, bad);
+        if (bad) failures++;
+    }
+
+    gl_tiles_shutdown();
+    atlas_shutdown();
+    context_shutdown();
+    if (failures) {
+        fprintf(stderr, "gl-bench: %d room(s) differ from the reference\n", failures);
+        return 1;
+    }
+    return 0;
+}
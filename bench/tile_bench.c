@@ -0,0 +1,66 @@
+/**
+ * tile_bench.c - Per-tile rasterizer cost table (make tile-bench)
+ *
+ * Times each draw_* rasterizer for every variant it knows, writing into
+ * a CPU bitmap exactly as atlas baking does. Also reports the draw_pixel/
+ * fill_tile calls and pixels each variant issues; before the atlas, each
+ * of those calls cost two SDL calls per tile per frame.
+ *
+ * Usage: tile-bench [--json] [iterations]
+ */
+
+#include "game.h"
+#include "tiles.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_ITERATIONS 2000
+
+int main(int argc, char *argv[]) {
+    bool json = false;
+    int iterations = DEFAULT_ITERATIONS;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) json = true;
+        else iterations = atoi(argv[i]);
+    }
+    if (iterations <= 0) iterations = DEFAULT_ITERATIONS;
+
+    double ns_per_tick = 1e9 / (double)SDL_GetPerformanceFrequency();
+    Color bitmap[TILE_SIZE * TILE_SIZE];
+    bool first = true;
+
+    if (json) printf("[\n");
+    else printf("type,variant,calls,pixels,ns\n");
+
+    for (int t = 0; t < TILE_TYPE_COUNT; t++) {
+        for (int v = 0; v < TILE_INFO[t].variants; v++) {
+            // One untimed pass for the counters (they are per call)
+            g_raster_stats = (RasterStats){0};
+            tile_rasterize((TileType)t, v, bitmap);
+            RasterStats stats = g_raster_stats;
+
+            uint64_t start = SDL_GetPerformanceCounter();
+            for (int i = 0; i < iterations; i++) {
+                tile_rasterize((TileType)t, v, bitmap);
+            }
+            double ns = (SDL_GetPerformanceCounter() - start) * ns_per_tick / iterations;
+
+            if (json) {
+                printf("%s  {\"type\": \"%s\", \"variant\": %d, \"calls\": %llu, "
+                       "\"pixels\": %llu, \"ns\": %.1f}",
+                       first ? "" : ",\n", TILE_INFO[t].name, v,
+                       (unsigned long long)stats.calls,
+                       (unsigned long long)stats.pixels, ns);
+            } else {
+                printf("%s,%d,%llu,%llu,%.1f\n", TILE_INFO[t].name, v,
+                       (unsigned long long)stats.calls,
+                       (unsigned long long)stats.pixels, ns);
+            }
+            first = false;
+        }
+    }
+
+    if (json) printf("\n]\n");
+    return 0;
+}
@@ -0,0 +1,328 @@
+/**
+ * atlas.c - Pre-baked tile atlas
+ *
+ * Tiles are rasterized into CPU bitmaps, deduplicated, and laid out in a
+ * grid of ATLAS_COLUMNS slots. The result is uploaded as one texture so
+ * drawing a tile is a single SDL_RenderCopy.
+ *
+ * Furniture with a fixed footprint (VARIANT_GRID types) is also baked as one
+ * whole-object sprite, packed on shelves below the tile slots, so a room
+ * draws each object with one copy instead of one per cell. The player
+ * sprite goes on the same shelves; it is the only one with transparency.
+ *
+ * Each slot is also kept as palette indices for the software framebuffer
+ * and the GL backend, which uploads them as an integer texture.
+ * The palette starts as PALETTE[0..3]; any other color a rasterizer uses
+ * (e.g. the floor checkerboard shade) is appended on first sight.
+ */
+
+#include "atlas.h"
+#include "tiles.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ATLAS_COLUMNS 32
+#define ATLAS_WIDTH (ATLAS_COLUMNS * TILE_SIZE)
+#define ATLAS_MAX_VARIANTS 64
+#define ATLAS_MAX_COLORS 255  // Index 255 is ATLAS_TRANSPARENT
+
+_Static_assert(PLAYER_SIZE == CHARACTER_SIZE, "Player sprite size mismatch");
+
+typedef Color TileBitmap[TILE_SIZE * TILE_SIZE];
+
+static SDL_Texture *atlas = NULL;
+static int slot_count = 0;
+static uint16_t slot_of[TILE_TYPE_COUNT][ATLAS_MAX_VARIANTS];
+
+static uint8_t (*indexed)[TILE_SIZE * TILE_SIZE] = NULL;
+static Color palette[ATLAS_MAX_COLORS];
+static int palette_size = 0;
+
+// Object sprites by type; rect.w == 0 for types drawn per tile
+typedef struct {
+    SDL_Rect rect;          // Position in the atlas texture
+    const uint8_t *bitmap;  // Palette indices, rect.w × rect.h row-major
+} Sprite;
+
+static Sprite sprites[TILE_TYPE_COUNT];
+static Sprite player;
+static uint8_t *sprite_pixels = NULL;
+static int sprite_count = 0;
+
+// FNV-1a over the raw bitmap bytes, used to skip most memcmp()s
+static uint32_t bitmap_hash(const TileBitmap bitmap) {
+    const uint8_t *bytes = (const uint8_t *)bitmap;
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < sizeof(TileBitmap); i++) {
+        h = (h ^ bytes[i]) * 16777619u;
+    }
+    return h;
+}
+
+// Palette index of a color, appending it if new
+static int palette_index(Color c) {
+    for (int i = 0; i < palette_size; i++) {
+        if (palette[i].r == c.r && palette[i].g == c.g && palette[i].b == c.b) return i;
+    }
+    if (palette_size == ATLAS_MAX_COLORS) return 0;
+    palette[palette_size] = c;
+    return palette_size++;
+}
+
+static SDL_Rect slot_rect(int slot) {
+    SDL_Rect r = {
+        (slot % ATLAS_COLUMNS) * TILE_SIZE,
+        (slot / ATLAS_COLUMNS) * TILE_SIZE,
+        TILE_SIZE, TILE_SIZE
+    };
+    return r;
+}
+
+// Next free w×h spot on the sprite shelves
+static SDL_Rect shelf_place(int *x, int *y, int *shelf, int w, int h) {
+    if (*x + w > ATLAS_WIDTH) {
+        *x = 0;
+        *y += *shelf;
+        *shelf = 0;
+    }
+    SDL_Rect r = {*x, *y, w, h};
+    *x += w;
+    if (h > *shelf) *shelf = h;
+    return r;
+}
+
+// Lay out the object sprites and the player on shelves starting at y = top
+// and compose them; returns the atlas height, or -1 on failure
+static int bake_sprites(int top) {
+    int x = 0, y = top, shelf = 0;
+    size_t bytes = 0;
+    sprite_count = 0;
+    for (int t = 0; t < TILE_TYPE_COUNT; t++) {
+        sprites[t] = (Sprite){{0, 0, 0, 0}, NULL};
+        if (!tile_is_sprite((TileType)t)) continue;
+        int w = TILE_INFO[t].width * TILE_SIZE, h = TILE_INFO[t].height * TILE_SIZE;
+        sprites[t].rect = shelf_place(&x, &y, &shelf, w, h);
+        bytes += (size_t)w * h;
+        sprite_count++;
+    }
+    player.rect = shelf_place(&x, &y, &shelf, PLAYER_SIZE, PLAYER_SIZE);
+    bytes += PLAYER_SIZE * PLAYER_SIZE;
+    sprite_count++;
+
+    free(sprite_pixels);
+    sprite_pixels = malloc(bytes ? bytes : 1);
+    if (!sprite_pixels) return -1;
+
+    uint8_t *out = sprite_pixels;
+    for (int t = 0; t < TILE_TYPE_COUNT; t++) {
+        if (!sprites[t].rect.w) continue;
+        int cols = TILE_INFO[t].width, rows = TILE_INFO[t].height;
+        int pitch = cols * TILE_SIZE;
+        for (int row = 0; row < rows; row++) {
+            for (int col = 0; col < cols; col++) {
+                const uint8_t *tile = indexed[slot_of[t][row * cols + col]];
+                for (int ty = 0; ty < TILE_SIZE; ty++) {
+                    memcpy(&out[(row * TILE_SIZE + ty) * pitch + col * TILE_SIZE],
+                           &tile[ty * TILE_SIZE], TILE_SIZE);
+                }
+            }
+        }
+        sprites[t].bitmap = out;
+        out += (size_t)pitch * rows * TILE_SIZE;
+    }
+
+    Color colors[PLAYER_SIZE * PLAYER_SIZE];
+    bool opaque[PLAYER_SIZE * PLAYER_SIZE];
+    character_rasterize(colors, opaque);
+    for (int i = 0; i < PLAYER_SIZE * PLAYER_SIZE; i++) {
+        out[i] = opaque[i] ? (uint8_t)palette_index(colors[i]) : ATLAS_TRANSPARENT;
+    }
+    player.bitmap = out;
+    return y + shelf;
+}
+
+#if !defined(RENDER_SOFTWARE) && !defined(RENDER_GL)
+// Palette index to a texture pixel
+static uint32_t atlas_pixel(const SDL_PixelFormat *format, uint8_t index) {
+    if (index == ATLAS_TRANSPARENT) return SDL_MapRGBA(format, 0, 0, 0, 0);
+    Color c = palette[index];
+    return SDL_MapRGBA(format, c.r, c.g, c.b, 255);
+}
+#endif
+
+bool atlas_init(SDL_Renderer *renderer) {
+    int total = 0;
+    for (int t = 0; t < TILE_TYPE_COUNT; t++) {
+        total += TILE_INFO[t].variants;
+    }
+
+    TileBitmap *bitmaps = malloc(sizeof(TileBitmap) * total);
+    uint32_t *hashes = malloc(sizeof(uint32_t) * total);
+    if (!bitmaps || !hashes) {
+        fprintf(stderr, "atlas: out of memory\n");
+        free(bitmaps);
+        free(hashes);
+        return false;
+    }
+
+    // Rasterize every pair, keeping only bitmaps not seen before
+    slot_count = 0;
+    for (int t = 0; t < TILE_TYPE_COUNT; t++) {
+        int variants = TILE_INFO[t].variants;
+        for (int v = 0; v < variants; v++) {
+            TileBitmap *candidate = &bitmaps[slot_count];
+            tile_rasterize((TileType)t, v, *candidate);
+            uint32_t h = bitmap_hash(*candidate);
+
+            int slot = slot_count;
+            for (int s = 0; s < slot_count; s++) {
+                if (hashes[s] == h && memcmp(bitmaps[s], *candidate, sizeof(TileBitmap)) == 0) {
+                    slot = s;
+                    break;
+                }
+            }
+            if (slot == slot_count) {
+                hashes[slot_count++] = h;
+            }
+            slot_of[t][v] = (uint16_t)slot;
+        }
+    }
+
+    // Convert the unique bitmaps to palette indices
+    free(indexed);
+    indexed = malloc(sizeof(*indexed) * slot_count);
+    if (!indexed) {
+        fprintf(stderr, "atlas: out of memory\n");
+        free(bitmaps);
+        free(hashes);
+        return false;
+    }
+    palette_size = 0;
+    for (int i = 0; i < 4; i++) palette_index(PALETTE[i]);
+    for (int s = 0; s < slot_count; s++) {
+        for (int i = 0; i < TILE_SIZE * TILE_SIZE; i++) {
+            indexed[s][i] = (uint8_t)palette_index(bitmaps[s][i]);
+        }
+    }
+    free(bitmaps);
+    free(hashes);
+
+    int rows = (slot_count + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS;
+    int height = bake_sprites(rows * TILE_SIZE);
+    if (height < 0) {
+        fprintf(stderr, "atlas: out of memory\n");
+        return false;
+    }
+
+#if defined(RENDER_SOFTWARE) || defined(RENDER_GL)
+    (void)renderer;  // The backend uses indexed[] and sprites directly
+#else
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(
+        0, ATLAS_WIDTH, height, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) {
+        fprintf(stderr, "atlas: SDL_CreateRGBSurfaceWithFormat failed: %s\n", SDL_GetError());
+        return false;
+    }
+
+    SDL_LockSurface(surface);
+    for (int s = 0; s < slot_count; s++) {
+        SDL_Rect r = slot_rect(s);
+        for (int y = 0; y < TILE_SIZE; y++) {
+            uint32_t *row = (uint32_t *)((uint8_t *)surface->pixels + (r.y + y) * surface->pitch);
+            for (int x = 0; x < TILE_SIZE; x++) {
+                row[r.x + x] = atlas_pixel(surface->format, indexed[s][y * TILE_SIZE + x]);
+            }
+        }
+    }
+    for (int t = 0; t <= TILE_TYPE_COUNT; t++) {
+        const Sprite *sprite = t < TILE_TYPE_COUNT ? &sprites[t] : &player;
+        SDL_Rect r = sprite->rect;
+        for (int y = 0; y < r.h; y++) {
+            uint32_t *row = (uint32_t *)((uint8_t *)surface->pixels + (r.y + y) * surface->pitch);
+            for (int x = 0; x < r.w; x++) {
+                row[r.x + x] = atlas_pixel(surface->format, sprite->bitmap[y * r.w + x]);
+            }
+        }
+    }
+    SDL_UnlockSurface(surface);
+
+    atlas = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+
+    if (!atlas) {
+        fprintf(stderr, "atlas: SDL_CreateTextureFromSurface failed: %s\n", SDL_GetError());
+        return false;
+    }
+    // Tiles are opaque; only the player's see-through pixels need blending
+    SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+#endif
+
+    printf("Atlas: %d tiles baked (%d unique, %d sprites, %d colors)\n",
+           total, slot_count, sprite_count, palette_size);
+    return true;
+}
+
+void atlas_shutdown(void) {
+#if !defined(RENDER_SOFTWARE) && !defined(RENDER_GL)
+    if (atlas) {
+        SDL_DestroyTexture(atlas);
+        atlas = NULL;
+    }
+#endif
+    free(indexed);
+    indexed = NULL;
+    slot_count = 0;
+    free(sprite_pixels);
+    sprite_pixels = NULL;
+    memset(sprites, 0, sizeof(sprites));
+    memset(&player, 0, sizeof(player));
+    sprite_count = 0;
+}
+
+SDL_Texture* atlas_texture(void) {
+    return atlas;
+}
+
+int atlas_tile_slot(TileType type, int variant) {
+    if (type >= TILE_TYPE_COUNT) type = TILE_FLOOR;
+    if (variant < 0 || variant >= TILE_INFO[type].variants) variant = 0;
+    return slot_of[type][variant];
+}
+
+SDL_Rect atlas_rect(TileType type, int variant) {
+    return slot_rect(atlas_tile_slot(type, variant));
+}
+
+const uint8_t* atlas_bitmap(TileType type, int variant) {
+    return indexed[atlas_tile_slot(type, variant)];
+}
+
+const uint8_t* atlas_slot_bitmap(int slot) {
+    return indexed[slot];
+}
+
+SDL_Rect atlas_sprite_rect(TileType type) {
+    return sprites[type].rect;
+}
+
+const uint8_t* atlas_sprite_bitmap(TileType type) {
+    return sprites[type].bitmap;
+}
+
+SDL_Rect atlas_player_rect(void) {
+    return player.rect;
+}
+
+const uint8_t* atlas_player_bitmap(void) {
+    return player.bitmap;
+}
+
+const Color* atlas_palette(int *count) {
+    *count = palette_size;
+    return palette;
+}
+
+int atlas_slot_count(void) {
+    return slot_count;
+}
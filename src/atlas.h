@@ -0,0 +1,50 @@
+/**
+ * atlas.h - Pre-baked tile atlas
+ *
+ * Every (TileType, variant) pair is rasterized once at startup into a
+ * single texture; identical 8x8 bitmaps share one atlas slot. Furniture
+ * types also get a whole-object sprite in the same texture, and so does the
+ * player character.
+ */
+
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#include "game.h"
+
+// Bake the atlas texture for a renderer (call once after renderer creation)
+bool atlas_init(SDL_Renderer *renderer);
+void atlas_shutdown(void);
+
+SDL_Texture* atlas_texture(void);
+
+// Source rect of a tile inside the atlas (unknown variants map to variant 0)
+SDL_Rect atlas_rect(TileType type, int variant);
+
+// Palette-indexed 8x8 bitmap of a tile (row-major, see atlas_palette)
+const uint8_t* atlas_bitmap(TileType type, int variant);
+
+// Whole-object sprite of a furniture type (see tile_is_sprite), its
+// registry footprint in size; drawing it equals drawing all of its cells
+SDL_Rect atlas_sprite_rect(TileType type);
+const uint8_t* atlas_sprite_bitmap(TileType type);
+
+// Player character sprite (PLAYER_SIZE square); see-through pixels are
+// ATLAS_TRANSPARENT in the bitmap and alpha 0 in the texture
+#define ATLAS_TRANSPARENT 255
+SDL_Rect atlas_player_rect(void);
+const uint8_t* atlas_player_bitmap(void);
+
+// Colors referenced by atlas_bitmap(); PALETTE[0..3] come first
+const Color* atlas_palette(int *count);
+
+// Number of unique tile bitmaps after deduplication
+int atlas_slot_count(void);
+
+// Slot of a tile, and a slot's bitmap, for backends that lay the slots
+// out themselves (RENDER_GL); atlas_bitmap(t, v) is
+// atlas_slot_bitmap(atlas_tile_slot(t, v))
+int atlas_tile_slot(TileType type, int variant);
+const uint8_t* atlas_slot_bitmap(int slot);
+
+#endif // ATLAS_H
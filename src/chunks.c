@@ -0,0 +1,117 @@
+/**
+ * chunks.c - LRU cache of rendered room chunks
+ */
+
+#include "chunks.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const Room *room;   // NULL if the slot is free
+    uint32_t serial;    // room->serial when the chunk was drawn
+    int16_t cx, cy;
+    uint32_t used;      // Frame of last use
+} ChunkEntry;
+
+static ChunkEntry *entries = NULL;
+static int capacity = 0;
+static int resident = 0;
+static uint32_t frame = 1;
+
+// Slots of one room's chunks, by chunk, so lookups are O(1); rebuilt from
+// the entries when another room is looked up
+static const Room *map_room = NULL;
+static uint32_t map_serial = 0;
+static int16_t map[ROOM_MAX_CHUNKS_Y][ROOM_MAX_CHUNKS_X];
+
+static bool entry_of(const ChunkEntry *e, const Room *room) {
+    return e->room == room && e->serial == room->serial;
+}
+
+static void map_select(const Room *room) {
+    if (room == map_room && room->serial == map_serial) return;
+    memset(map, 0xFF, sizeof(map));
+    for (int i = 0; i < capacity; i++) {
+        if (entry_of(&entries[i], room)) map[entries[i].cy][entries[i].cx] = (int16_t)i;
+    }
+    map_room = room;
+    map_serial = room->serial;
+}
+
+bool chunks_init(int slots) {
+    chunks_shutdown();
+    if (slots < CHUNK_MIN_SLOTS) slots = CHUNK_MIN_SLOTS;
+    if (slots > CHUNK_MAX_SLOTS) slots = CHUNK_MAX_SLOTS;
+    entries = calloc((size_t)slots, sizeof(ChunkEntry));
+    if (!entries) {
+        fprintf(stderr, "chunks: out of memory\n");
+        return false;
+    }
+    capacity = slots;
+    chunks_clear();
+    return true;
+}
+
+void chunks_shutdown(void) {
+    free(entries);
+    entries = NULL;
+    capacity = resident = 0;
+    map_room = NULL;
+}
+
+int chunks_capacity(void) {
+    return capacity;
+}
+
+int chunks_resident(void) {
+    return resident;
+}
+
+void chunks_begin_frame(void) {
+    frame++;
+}
+
+int chunk_find(const Room *room, int cx, int cy) {
+    if (cx < 0 || cy < 0 || cx >= ROOM_MAX_CHUNKS_X || cy >= ROOM_MAX_CHUNKS_Y) return -1;
+    map_select(room);
+    return map[cy][cx];
+}
+
+void chunk_touch(int slot) {
+    entries[slot].used = frame;
+}
+
+int chunk_claim(const Room *room, int cx, int cy, int min_age) {
+    if (cx < 0 || cy < 0 || cx >= ROOM_MAX_CHUNKS_X || cy >= ROOM_MAX_CHUNKS_Y) return -1;
+
+    int slot = -1;
+    for (int i = 0; i < capacity; i++) {
+        if (!entries[i].room) {
+            slot = i;
+            break;
+        }
+        if (frame - entries[i].used >= (uint32_t)min_age &&
+            (slot < 0 || entries[i].used < entries[slot].used)) {
+            slot = i;
+        }
+    }
+    if (slot < 0) return -1;
+
+    ChunkEntry *e = &entries[slot];
+    if (e->room) {
+        if (e->room == map_room && e->serial == map_serial) map[e->cy][e->cx] = -1;
+    } else {
+        resident++;
+    }
+    *e = (ChunkEntry){room, room->serial, (int16_t)cx, (int16_t)cy, frame};
+    map_select(room);
+    map[cy][cx] = (int16_t)slot;
+    return slot;
+}
+
+void chunks_clear(void) {
+    if (entries) memset(entries, 0, sizeof(ChunkEntry) * capacity);
+    resident = 0;
+    map_room = NULL;
+}
@@ -0,0 +1,49 @@
+/**
+ * chunks.h - LRU cache of rendered room chunks
+ *
+ * Rooms are rasterized in CHUNK_TILES × CHUNK_TILES chunks, on demand, into
+ * a fixed pool of slots that the renderer owns (texture pages, or indexed
+ * bitmaps for RENDER_SOFTWARE). This module only keeps the books: which
+ * chunk of which room sits in each slot, and which slot to reuse next.
+ */
+
+#ifndef CHUNKS_H
+#define CHUNKS_H
+
+#include "game.h"
+
+#define CHUNK_TILES 16
+#define CHUNK_PX (CHUNK_TILES * TILE_SIZE)
+#define ROOM_MAX_CHUNKS_X (ROOM_MAX_WIDTH / CHUNK_TILES)
+#define ROOM_MAX_CHUNKS_Y (ROOM_MAX_HEIGHT / CHUNK_TILES)
+
+// Most chunks the screen can overlap at once; the pool never has fewer
+#define CHUNK_MIN_SLOTS (((WINDOW_WIDTH + CHUNK_PX - 2) / CHUNK_PX + 1) * \
+                         ((WINDOW_HEIGHT + CHUNK_PX - 2) / CHUNK_PX + 1))
+#define CHUNK_MAX_SLOTS 256
+
+bool chunks_init(int slots);
+void chunks_shutdown(void);
+int chunks_capacity(void);
+int chunks_resident(void);
+
+// Start a frame: chunks used from here on are not evicted until the next
+void chunks_begin_frame(void);
+
+// Slot holding chunk (cx, cy) of a room, or -1 if it is not cached. Chunks
+// are keyed by the room's load serial too, so a room that was unloaded and
+// loaded again never sees chunks of its earlier tiles
+int chunk_find(const Room *room, int cx, int cy);
+
+// Mark a slot as used this frame
+void chunk_touch(int slot);
+
+// Take a slot for a chunk that is not cached: a free one, else the least
+// recently used one not touched in the last min_age frames (1: not this
+// frame). -1 if there is none. The caller rasterizes the chunk into it.
+int chunk_claim(const Room *room, int cx, int cy, int min_age);
+
+// Forget every chunk (e.g. after the textures holding them were lost)
+void chunks_clear(void);
+
+#endif // CHUNKS_H
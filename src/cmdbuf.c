@@ -0,0 +1,249 @@
+/**
+ * cmdbuf.c - Render command buffer
+ */
+
+#include "cmdbuf.h"
+#include "stats.h"
+#include <string.h>
+
+#ifdef PLATFORM_HTML5
+#include "framebuffer.h"
+#endif
+
+#define CMD_MAX 8192        // Commands per flush; more flushes early
+#define CMD_MAX_STATES 32   // Distinct textures/colors per flush
+#define CMD_BATCH 1024      // Quads or rects per SDL call
+
+typedef struct {
+    SDL_Texture *texture;   // NULL for fills
+    Color color;
+    uint8_t alpha;
+} CmdState;
+
+typedef struct {
+    SDL_Rect src, dst;
+    uint16_t key;           // layer * CMD_MAX_STATES + state
+} Cmd;
+
+static SDL_Renderer *cmd_renderer = NULL;
+static Cmd cmds[CMD_MAX];
+static Cmd sorted[CMD_MAX];
+static int cmd_count = 0;
+static CmdState states[CMD_MAX_STATES];
+static int state_count = 0;
+static int last_state = -1;
+
+// Batch scratch: vertices and indices for SDL_RenderGeometry, rects for fills
+static SDL_Rect fill_rects[CMD_BATCH];
+#ifndef PLATFORM_HTML5
+static SDL_Vertex vertices[CMD_BATCH * 4];
+static int indices[CMD_BATCH * 6];
+static bool geometry_supported = true;
+#endif
+
+void cmd_begin(SDL_Renderer *renderer) {
+    cmd_renderer = renderer;
+    cmd_count = 0;
+    state_count = 0;
+    last_state = -1;
+
+#ifndef PLATFORM_HTML5
+    if (indices[5] == 0) {
+        for (int q = 0; q < CMD_BATCH; q++) {
+            int v = q * 4;
+            int *i = &indices[q * 6];
+            i[0] = v; i[1] = v + 1; i[2] = v + 2;
+            i[3] = v; i[4] = v + 2; i[5] = v + 3;
+        }
+    }
+#endif
+}
+
+// State slot for a texture/color, or -1 if the table is full
+static int state_index(SDL_Texture *texture, Color color, uint8_t alpha) {
+    if (last_state >= 0) {
+        const CmdState *s = &states[last_state];
+        if (s->texture == texture && s->alpha == alpha && s->color.r == color.r &&
+            s->color.g == color.g && s->color.b == color.b) return last_state;
+    }
+    for (int i = 0; i < state_count; i++) {
+        const CmdState *s = &states[i];
+        if (s->texture == texture && s->alpha == alpha && s->color.r == color.r &&
+            s->color.g == color.g && s->color.b == color.b) return last_state = i;
+    }
+    if (state_count == CMD_MAX_STATES) return -1;
+    states[state_count] = (CmdState){texture, color, alpha};
+    return last_state = state_count++;
+}
+
+static void record(CmdLayer layer, SDL_Texture *texture, Color color, uint8_t alpha,
+                   SDL_Rect src, SDL_Rect dst) {
+    int state = state_index(texture, color, alpha);
+    if (state < 0 || cmd_count == CMD_MAX) {
+        cmd_flush();  // Everything so far goes out in order first
+        state = state_index(texture, color, alpha);
+    }
+    cmds[cmd_count++] = (Cmd){src, dst, (uint16_t)(layer * CMD_MAX_STATES + state)};
+}
+
+void cmd_copy_alpha(CmdLayer layer, SDL_Texture *texture, const SDL_Rect *src,
+                    const SDL_Rect *dst, uint8_t alpha) {
+#ifdef PLATFORM_HTML5
+    // No textures in this build (platform_html5.c): only fills are drawn
+    (void)layer;
+    (void)texture;
+    (void)src;
+    (void)dst;
+    (void)alpha;
+#else
+    SDL_Rect s = {0, 0, 0, 0};
+    if (src) s = *src;
+    else SDL_QueryTexture(texture, NULL, NULL, &s.w, &s.h);
+    SDL_Rect d = dst ? *dst : (SDL_Rect){0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
+    record(layer, texture, (Color){255, 255, 255}, alpha, s, d);
+#endif
+}
+
+void cmd_copy(CmdLayer layer, SDL_Texture *texture, const SDL_Rect *src, const SDL_Rect *dst) {
+    cmd_copy_alpha(layer, texture, src, dst, 255);
+}
+
+void cmd_fill(CmdLayer layer, Color color, uint8_t alpha, const SDL_Rect *dst) {
+    record(layer, NULL, color, alpha, (SDL_Rect){0, 0, 0, 0}, *dst);
+}
+
+// ----------------------------------------------------------------------------
+// Submission
+// ----------------------------------------------------------------------------
+
+#ifdef PLATFORM_HTML5
+
+// Bounds of the fills in this flush
+static SDL_Rect drawn = {0, 0, 0, 0};
+
+static void submit_fills(const CmdState *state, const Cmd *run, int n) {
+    for (int start = 0; start < n; start += CMD_BATCH) {
+        int count = n - start < CMD_BATCH ? n - start : CMD_BATCH;
+        for (int i = 0; i < count; i++) {
+            const SDL_Rect *r = &run[start + i].dst;
+            fill_rects[i] = *r;
+            if (drawn.w == 0) {
+                drawn = *r;
+                continue;
+            }
+            int x1 = drawn.x + drawn.w, y1 = drawn.y + drawn.h;
+            if (r->x + r->w > x1) x1 = r->x + r->w;
+            if (r->y + r->h > y1) y1 = r->y + r->h;
+            if (r->x < drawn.x) drawn.x = r->x;
+            if (r->y < drawn.y) drawn.y = r->y;
+            drawn.w = x1 - drawn.x;
+            drawn.h = y1 - drawn.y;
+        }
+        platform_fill_rects(fill_rects, count, state->color, state->alpha);
+        g_frame_stats.draw_calls++;
+    }
+    g_frame_stats.color_changes++;
+}
+
+#else
+
+static void submit_copies(SDL_Texture *texture, uint8_t alpha, const Cmd *run, int n) {
+    if (!geometry_supported) {
+        if (alpha < 255) SDL_SetTextureAlphaMod(texture, alpha);
+        for (int i = 0; i < n; i++) {
+            SDL_RenderCopy(cmd_renderer, texture, &run[i].src, &run[i].dst);
+            g_frame_stats.draw_calls++;
+        }
+        if (alpha < 255) SDL_SetTextureAlphaMod(texture, 255);
+        return;
+    }
+
+    int tw, th;
+    SDL_QueryTexture(texture, NULL, NULL, &tw, &th);
+    float sx = 1.0f / tw, sy = 1.0f / th;
+    SDL_Color white = {255, 255, 255, alpha};
+
+    for (int start = 0; start < n; start += CMD_BATCH) {
+        int count = n - start < CMD_BATCH ? n - start : CMD_BATCH;
+        for (int q = 0; q < count; q++) {
+            const SDL_Rect *s = &run[start + q].src, *d = &run[start + q].dst;
+            float x0 = (float)d->x, y0 = (float)d->y;
+            float x1 = (float)(d->x + d->w), y1 = (float)(d->y + d->h);
+            float u0 = s->x * sx, v0 = s->y * sy;
+            float u1 = (s->x + s->w) * sx, v1 = (s->y + s->h) * sy;
+            SDL_Vertex *v = &vertices[q * 4];
+            v[0] = (SDL_Vertex){{x0, y0}, white, {u0, v0}};
+            v[1] = (SDL_Vertex){{x1, y0}, white, {u1, v0}};
+            v[2] = (SDL_Vertex){{x1, y1}, white, {u1, v1}};
+            v[3] = (SDL_Vertex){{x0, y1}, white, {u0, v1}};
+        }
+        if (SDL_RenderGeometry(cmd_renderer, texture, vertices, count * 4,
+                               indices, count * 6) < 0) {
+            // Renderer without geometry support: copy one by one from now on
+            geometry_supported = false;
+            submit_copies(texture, alpha, run + start, n - start);
+            return;
+        }
+        g_frame_stats.draw_calls++;
+    }
+}
+
+static void submit_fills(const CmdState *state, const Cmd *run, int n) {
+    bool blend = state->alpha > 0 && state->alpha < 255;
+    SDL_SetRenderDrawBlendMode(cmd_renderer, blend ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(cmd_renderer, state->color.r, state->color.g, state->color.b,
+                           state->alpha);
+    g_frame_stats.color_changes++;
+
+    for (int start = 0; start < n; start += CMD_BATCH) {
+        int count = n - start < CMD_BATCH ? n - start : CMD_BATCH;
+        for (int i = 0; i < count; i++) fill_rects[i] = run[start + i].dst;
+        SDL_RenderFillRects(cmd_renderer, fill_rects, count);
+        g_frame_stats.draw_calls++;
+    }
+    if (blend) SDL_SetRenderDrawBlendMode(cmd_renderer, SDL_BLENDMODE_NONE);
+}
+
+#endif // PLATFORM_HTML5
+
+void cmd_flush(void) {
+#ifdef PLATFORM_HTML5
+    if (cmd_count == 0) return;
+#else
+    if (cmd_count == 0 || !cmd_renderer) {
+        cmd_count = 0;
+        return;
+    }
+#endif
+
+    // Stable counting sort on (layer, state)
+    enum { KEYS = CMD_LAYER_COUNT * CMD_MAX_STATES };
+    int offsets[KEYS + 1];
+    memset(offsets, 0, sizeof(offsets));
+    for (int i = 0; i < cmd_count; i++) offsets[cmds[i].key + 1]++;
+    for (int k = 0; k < KEYS; k++) offsets[k + 1] += offsets[k];
+    for (int i = 0; i < cmd_count; i++) sorted[offsets[cmds[i].key]++] = cmds[i];
+
+    for (int start = 0; start < cmd_count;) {
+        int end = start + 1;
+        while (end < cmd_count && sorted[end].key == sorted[start].key) end++;
+        const CmdState *state = &states[sorted[start].key % CMD_MAX_STATES];
+#ifdef PLATFORM_HTML5
+        submit_fills(state, &sorted[start], end - start);
+#else
+        if (state->texture) submit_copies(state->texture, state->alpha, &sorted[start], end - start);
+        else submit_fills(state, &sorted[start], end - start);
+#endif
+        start = end;
+    }
+#ifdef PLATFORM_HTML5
+    // The canvas keeps what was filled over the frame; marking it dirty
+    // makes the next fb_present() put the frame back under it
+    fb_mark_dirty(drawn.x, drawn.y, drawn.w, drawn.h);
+    drawn = (SDL_Rect){0, 0, 0, 0};
+#endif
+
+    cmd_count = 0;
+    state_count = 0;
+    last_state = -1;
+}
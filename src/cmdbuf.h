@@ -0,0 +1,50 @@
+/**
+ * cmdbuf.h - Render command buffer
+ *
+ * Draws are recorded into fixed arrays instead of going straight to SDL.
+ * cmd_flush() orders them by layer and then by state (texture or fill
+ * color) and submits each run as one batch: SDL_RenderGeometry for
+ * texture copies, SDL_RenderFillRects for fills. The html5 platform has
+ * no SDL: copies are dropped and fills go to the canvas over the software
+ * framebuffer (platform_fill_rects), which is enough for the HUD.
+ *
+ * Within a layer, commands with different states may be reordered, so a
+ * layer must only hold draws that do not overlap unless they share a
+ * state; commands with the same state keep their recorded order.
+ */
+
+#ifndef CMDBUF_H
+#define CMDBUF_H
+
+#include "game.h"
+
+// Submission order
+typedef enum {
+    CMD_LAYER_WORLD = 0,    // Room tiles and sprites (the floor layer)
+    CMD_LAYER_FURNITURE,    // Cached furniture layer
+    CMD_LAYER_ACTORS,       // Player and other characters
+    CMD_LAYER_OVERLAY,      // Room transition fading out over the new room
+    CMD_LAYER_UI_BACK,      // HUD panel
+    CMD_LAYER_UI,           // HUD text and graph
+    CMD_LAYER_UI_FRONT,     // HUD markers over the graph
+    CMD_LAYER_COUNT
+} CmdLayer;
+
+// Start recording for a renderer (drops anything not yet flushed)
+void cmd_begin(SDL_Renderer *renderer);
+
+// Copy src of a texture to dst (NULL src = whole texture, NULL dst = whole target)
+void cmd_copy(CmdLayer layer, SDL_Texture *texture, const SDL_Rect *src, const SDL_Rect *dst);
+
+// Same, with the texture's colors scaled by alpha/255 (it must blend)
+void cmd_copy_alpha(CmdLayer layer, SDL_Texture *texture, const SDL_Rect *src,
+                    const SDL_Rect *dst, uint8_t alpha);
+
+// Fill a rect; alpha below 255 blends, alpha 0 clears it to transparent
+void cmd_fill(CmdLayer layer, Color color, uint8_t alpha, const SDL_Rect *dst);
+
+// Sort and submit everything recorded since cmd_begin() or the last flush.
+// Call before any direct SDL drawing or render target change.
+void cmd_flush(void);
+
+#endif // CMDBUF_H
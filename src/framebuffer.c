@@ -0,0 +1,146 @@
+/**
+ * framebuffer.c - Indexed software framebuffer (RENDER_SOFTWARE backend)
+ *
+ * Indices are one byte per pixel rather than packed 2bpp: byte stores need
+ * no read-modify-write, and the atlas palette has a fifth entry for the
+ * floor checkerboard shade.
+ */
+
+#include "framebuffer.h"
+#include "atlas.h"
+#include "platform.h"
+#include "pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+uint8_t g_framebuffer[WINDOW_HEIGHT][WINDOW_WIDTH];
+
+static uint32_t *fb_pixels = NULL;  // Platform-format staging buffer
+static uint32_t lut[256];
+
+// Regions changed since the last fb_present(); overflow uploads everything
+#define FB_MAX_DIRTY 64
+static SDL_Rect dirty[FB_MAX_DIRTY];
+static int dirty_count = 0;
+static bool dirty_all = true;
+
+bool fb_init(void) {
+    if (!platform_fb_init()) return false;
+
+    fb_pixels = malloc(sizeof(uint32_t) * WINDOW_WIDTH * WINDOW_HEIGHT);
+    if (!fb_pixels) {
+        fprintf(stderr, "fb: out of memory\n");
+        platform_fb_shutdown();
+        return false;
+    }
+
+    int colors;
+    const Color *palette = atlas_palette(&colors);
+    memset(lut, 0, sizeof(lut));
+    for (int i = 0; i < colors; i++) {
+        lut[i] = platform_rgb(palette[i]);
+    }
+    dirty_all = true;
+    return true;
+}
+
+void fb_shutdown(void) {
+    platform_fb_shutdown();
+    free(fb_pixels);
+    fb_pixels = NULL;
+}
+
+SDL_Rect fb_band(int band) {
+    int y = band * FB_BAND_HEIGHT;
+    int h = WINDOW_HEIGHT - y < FB_BAND_HEIGHT ? WINDOW_HEIGHT - y : FB_BAND_HEIGHT;
+    return (SDL_Rect){0, y, WINDOW_WIDTH, h};
+}
+
+void fb_fill_tile(int px, int py, uint8_t index) {
+    int x0 = px < 0 ? 0 : px, y0 = py < 0 ? 0 : py;
+    int x1 = px + TILE_SIZE > WINDOW_WIDTH ? WINDOW_WIDTH : px + TILE_SIZE;
+    int y1 = py + TILE_SIZE > WINDOW_HEIGHT ? WINDOW_HEIGHT : py + TILE_SIZE;
+    for (int y = y0; y < y1; y++) {
+        memset(&g_framebuffer[y][x0], index, (size_t)(x1 > x0 ? x1 - x0 : 0));
+    }
+}
+
+// Copy a w×h bitmap to (px, py), clipped to the screen; keyed skips
+// ATLAS_TRANSPARENT pixels
+static void blit(int px, int py, int w, int h, const uint8_t *bitmap, bool keyed) {
+    int x0 = px < 0 ? -px : 0, y0 = py < 0 ? -py : 0;
+    int x1 = px + w > WINDOW_WIDTH ? WINDOW_WIDTH - px : w;
+    int y1 = py + h > WINDOW_HEIGHT ? WINDOW_HEIGHT - py : h;
+    if (x0 >= x1 || y0 >= y1) return;
+    for (int y = y0; y < y1; y++) {
+        uint8_t *dst = &g_framebuffer[py + y][px];
+        const uint8_t *src = bitmap + y * w;
+        if (!keyed) {
+            memcpy(dst + x0, src + x0, (size_t)(x1 - x0));
+            continue;
+        }
+        for (int x = x0; x < x1; x++) {
+            if (src[x] != ATLAS_TRANSPARENT) dst[x] = src[x];
+        }
+    }
+}
+
+void fb_blit_tile(int px, int py, const uint8_t *bitmap) {
+    blit(px, py, TILE_SIZE, TILE_SIZE, bitmap, false);
+}
+
+void fb_blit_sprite_keyed(int px, int py, int w, int h, const uint8_t *bitmap) {
+    blit(px, py, w, h, bitmap, true);
+}
+
+void fb_clear(uint8_t index) {
+    memset(g_framebuffer, index, sizeof(g_framebuffer));
+    dirty_all = true;
+}
+
+void fb_mark_dirty(int x, int y, int w, int h) {
+    if (dirty_all) return;
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > WINDOW_WIDTH) w = WINDOW_WIDTH - x;
+    if (y + h > WINDOW_HEIGHT) h = WINDOW_HEIGHT - y;
+    if (w <= 0 || h <= 0) return;
+    if (dirty_count == FB_MAX_DIRTY || (w >= WINDOW_WIDTH && h >= WINDOW_HEIGHT)) {
+        dirty_all = true;
+        return;
+    }
+    dirty[dirty_count++] = (SDL_Rect){x, y, w, h};
+}
+
+// Expand one region through the LUT
+static void expand_rect(SDL_Rect r) {
+    for (int y = r.y; y < r.y + r.h; y++) {
+        const uint8_t *src = &g_framebuffer[y][r.x];
+        uint32_t *dst = &fb_pixels[y * WINDOW_WIDTH + r.x];
+        for (int x = 0; x < r.w; x++) {
+            dst[x] = lut[src[x]];
+        }
+    }
+}
+
+static void expand_band(void *ctx, int band) {
+    (void)ctx;
+    expand_rect(fb_band(band));
+}
+
+// Dirty regions may overlap, so only the full screen is split across threads
+void fb_present(void) {
+    if (dirty_all) {
+        pool_run(FB_BANDS, expand_band, NULL);
+        dirty[0] = (SDL_Rect){0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
+        dirty_count = 1;
+    } else {
+        for (int i = 0; i < dirty_count; i++) {
+            expand_rect(dirty[i]);
+        }
+    }
+    platform_fb_update(fb_pixels, dirty, dirty_count);
+    dirty_all = false;
+    dirty_count = 0;
+}
@@ -0,0 +1,56 @@
+/**
+ * framebuffer.h - Indexed software framebuffer (RENDER_SOFTWARE backend)
+ *
+ * The frame is drawn as one palette index per pixel in wasm memory, then
+ * expanded to the platform's pixel format through a lookup table and
+ * handed to platform_fb_update(). Only regions marked with fb_mark_dirty()
+ * are converted and uploaded again.
+ */
+
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include "game.h"
+
+// Palette indices, row-major (640 rows × 400 cols)
+extern uint8_t g_framebuffer[WINDOW_HEIGHT][WINDOW_WIDTH];
+
+// Full-screen passes are split into horizontal bands of tile rows, one
+// pool_run() item each (pool.h)
+#define FB_BAND_HEIGHT (4 * TILE_SIZE)
+#define FB_BANDS ((WINDOW_HEIGHT + FB_BAND_HEIGHT - 1) / FB_BAND_HEIGHT)
+
+// Screen rect of band 0..FB_BANDS-1
+SDL_Rect fb_band(int band);
+
+// Set up the platform's output and build the LUT from the atlas palette
+bool fb_init(void);
+void fb_shutdown(void);
+
+// Software equivalents of render.c's draw_pixel/fill_tile: palette
+// bytes written straight into g_framebuffer, clipped to the screen.
+// fb_draw_pixel is inline for per-pixel passes (the transition dissolve).
+static inline void fb_draw_pixel(int x, int y, uint8_t index) {
+    if (x < 0 || x >= WINDOW_WIDTH || y < 0 || y >= WINDOW_HEIGHT) return;
+    g_framebuffer[y][x] = index;
+}
+void fb_fill_tile(int px, int py, uint8_t index);
+
+// Copy an 8x8 indexed bitmap (see atlas_bitmap) to a pixel position; the
+// blits clip to the screen, so scrolled-off parts are simply dropped
+void fb_blit_tile(int px, int py, const uint8_t *bitmap);
+
+// Copy a w×h indexed bitmap to a pixel position, skipping
+// ATLAS_TRANSPARENT pixels (see atlas_player_bitmap)
+void fb_blit_sprite_keyed(int px, int py, int w, int h, const uint8_t *bitmap);
+
+void fb_clear(uint8_t index);
+
+// Record a changed pixel region for the next fb_present() (clipped)
+void fb_mark_dirty(int x, int y, int w, int h);
+
+// Expand the changed regions through the LUT and put the frame on screen;
+// a full-screen update is expanded band by band on the pool
+void fb_present(void);
+
+#endif // FRAMEBUFFER_H
@@ -3,56 +3,225 @@
  */
 
 #include "game.h"
+#include "atlas.h"
 #include "render.h"
 #include "room.h"
+#include "stats.h"
 #include <stdio.h>
 
-#ifdef __EMSCRIPTEN__
-#include <emscripten.h>
-#endif
-
 // ----------------------------------------------------------------------------
 // Globals
 // ----------------------------------------------------------------------------
 
 GameState g_game = {0};
 
-const Color PALETTE[4] = {
-    {0x0F, 0x38, 0x0F},  // 0: bg-dark (background)
-    {0x30, 0x62, 0x30},  // 1: fg-mid (shadows/secondary)
-    {0x8B, 0xAC, 0x0F},  // 2: bg-light (highlights)
-    {0x9B, 0xBC, 0x0F},  // 3: fg-light (primary)
-};
-
 // ----------------------------------------------------------------------------
 // Main loop
 // ----------------------------------------------------------------------------
 
-static void handle_input(void) {
-    SDL_Event event;
-    while (SDL_PollEvent(&event)) {
-        switch (event.type) {
-            case SDL_QUIT:
-                g_game.running = false;
-                break;
-            case SDL_KEYDOWN:
-                if (event.key.keysym.sym == SDLK_ESCAPE) {
-                    g_game.running = false;
-                }
-                break;
+// Returns true if any event arrived (key, window, quit...)
+static bool handle_input(void) {
+    uint32_t events = platform_poll();
+    if (events & EVENT_QUIT) {
+        g_game.running = false;
+    }
+    if (events & EVENT_TOGGLE_HUD) {
+        stats_toggle_overlay();
+    }
+    if (events & EVENT_DEVICE_RESET) {
+        // All textures are gone; bake the atlas again
+        render_shutdown();
+        atlas_shutdown();
+        if (!atlas_init(g_game.renderer) || !render_init()) {
+            g_game.running = false;
         }
+    } else if (events & EVENT_TARGETS_RESET) {
+        render_invalidate();
+    }
+    return events != 0;
+}
+
+// Catch-up limit: after a stall (tab in background, breakpoint) the world
+// runs at most this many steps in one frame and drops the rest
+#define MAX_STEPS_PER_FRAME 5
+
+static uint64_t last_counter = 0;
+static double accumulator = 0.0;  // Unsimulated time, in seconds
+
+// Idle mode: frames with no input, no movement and nothing to redraw skip
+// simulation and rendering, and tell platform_run() it may sleep
+
+// Place the player on one of the room's entry points (the first if there
+// is no such entry)
+static void player_spawn(const Room *room, int entry) {
+    g_game.player = (Player){0, 0, 0, 0};
+    if (entry >= room->entry_count) entry = 0;
+    if (room->entry_count > 0) {
+        g_game.player.x = room->entries[entry].x * TILE_SIZE;
+        g_game.player.y = room->entries[entry].y * TILE_SIZE;
+    }
+    g_game.player.prev_x = g_game.player.x;
+    g_game.player.prev_y = g_game.player.y;
+}
+
+void player_draw_pos(float *x, float *y) {
+    const Player *p = &g_game.player;
+    *x = p->prev_x + (p->x - p->prev_x) * g_game.alpha;
+    *y = p->prev_y + (p->y - p->prev_y) * g_game.alpha;
+}
+
+// Arrow keys / WASD as a step of PLAYER_SPEED per axis
+static void player_input(int *dx, int *dy) {
+    uint32_t input = platform_input();
+    *dx = 0;
+    *dy = 0;
+    if (input & INPUT_LEFT) *dx -= PLAYER_SPEED;
+    if (input & INPUT_RIGHT) *dx += PLAYER_SPEED;
+    if (input & INPUT_UP) *dy -= PLAYER_SPEED;
+    if (input & INPUT_DOWN) *dy += PLAYER_SPEED;
+}
+
+// Whether the player's feet fit with the sprite's top-left at (x, y)
+static bool player_fits(const Room *room, int x, int y) {
+    return y >= 0 && room_box_walkable(room, x, y + PLAYER_SIZE - PLAYER_FEET,
+                                       PLAYER_SIZE, PLAYER_FEET);
+}
+
+// Each axis moves on its own so the player slides along walls instead of
+// sticking to them
+static void player_move(const Room *room) {
+    int dx, dy;
+    player_input(&dx, &dy);
+
+    Player *p = &g_game.player;
+    p->prev_x = p->x;
+    p->prev_y = p->y;
+    if (dx && player_fits(room, p->x + dx, p->y)) {
+        p->x += dx;
+    }
+    if (dy && player_fits(room, p->x, p->y + dy)) {
+        p->y += dy;
+    }
+}
+
+// A door fires when the player's feet step onto it. Entering a room puts
+// the player just inside its door, so doors then stay off until the feet
+// are clear of every door and the movement keys have changed: holding a
+// key walks into the new room's door without going back through it.
+static bool doors_armed = true;
+static int door_dx, door_dy;    // Movement keys held when the last door fired
+
+static void check_doors(void) {
+    const Player *p = &g_game.player;
+    const RoomDoor *door = room_door_at(g_game.current_room, p->x, p->y + PLAYER_SIZE - PLAYER_FEET,
+                                        PLAYER_SIZE, PLAYER_FEET);
+    int dx, dy;
+    player_input(&dx, &dy);
+    if (!doors_armed) {
+        doors_armed = !door && (dx != door_dx || dy != door_dy);
+        return;
     }
+    if (!door) return;
+    doors_armed = false;
+    door_dx = dx;
+    door_dy = dy;
+
+    // Normally loaded and baked already by prefetch_neighbors()
+    Room *next = room_get(door->to);
+    if (!next) return;
+    render_begin_transition();
+    g_game.current_room = next;
+    room_enter(door->to);
+    player_spawn(next, door->entry);
+    printf("Entered %s\n", next->name);
 }
 
 static void update(void) {
-    // Game logic goes here
+    if (g_game.current_room) {
+        player_move(g_game.current_room);
+        check_doors();
+    }
     g_game.frame++;
 }
 
-static void main_loop(void) {
-    handle_input();
-    update();
+// The rooms behind the current room's doors are decoded, and the view at
+// their entry point baked, ahead of time so walking through a door never
+// waits on either. One step per frame: a room decode or a few chunks.
+// Returns true while there is work left.
+static bool prefetch_neighbors(void) {
+    static bool failed[ROOM_COUNT];  // Rooms that did not load; not retried
+    Room *room = g_game.current_room;
+    if (!room) return false;
+    const RoomDoor *doors;
+    int count = room_doors(room_id(room), &doors);
+    for (int i = 0; i < count; i++) {
+        if (failed[doors[i].to]) continue;
+        Room *next = room_peek(doors[i].to);
+        if (!next) {
+            failed[doors[i].to] = !room_get(doors[i].to);
+            return true;
+        }
+        int entry = doors[i].entry < next->entry_count ? doors[i].entry : 0;
+        int x = next->entry_count ? next->entries[entry].x * TILE_SIZE : 0;
+        int y = next->entry_count ? next->entries[entry].y * TILE_SIZE : 0;
+        if (render_prefetch(next, x, y)) return true;
+    }
+    return false;
+}
+
+// Run as many fixed steps as the elapsed time covers
+static void simulate(void) {
+    const double step = 1.0 / UPDATE_HZ;
+    uint64_t now = platform_ticks();
+    if (last_counter != 0) {
+        accumulator += (double)(now - last_counter) / platform_tick_rate();
+    }
+    last_counter = now;
+
+    int steps = 0;
+    while (accumulator >= step && steps < MAX_STEPS_PER_FRAME) {
+        update();
+        accumulator -= step;
+        steps++;
+    }
+    if (accumulator >= step) accumulator = 0.0;  // Too far behind: drop it
+
+    g_game.alpha = (float)(accumulator / step);
+}
+
+// Moving, or about to: a held key sends no events after the first
+static bool player_active(void) {
+    const Player *p = &g_game.player;
+    int dx, dy;
+    player_input(&dx, &dy);
+    return dx || dy || p->x != p->prev_x || p->y != p->prev_y;
+}
+
+static FrameResult main_loop(void) {
+    stats_begin_frame();
+    bool input = handle_input();
+
+    bool still = !input && !player_active() && !render_pending();
+    if (still) {
+        // The clock restarts on wake-up, so idle time is not caught up.
+        // Frames with nothing to draw still prefetch; the loop only
+        // blocks once that is done.
+        last_counter = 0;
+        accumulator = 0.0;
+        bool idle = !prefetch_neighbors();
+        stats_idle_frame();
+        return idle ? FRAME_IDLE : FRAME_BUSY;
+    }
+    stats_mark(STATS_INPUT);
+    simulate();
+    prefetch_neighbors();
+    stats_mark(STATS_UPDATE);
     render_frame();
+    stats_mark(STATS_RENDER);
+    render_present();
+    stats_mark(STATS_PRESENT);
+    stats_end_frame();
+    return g_game.running ? FRAME_DRAWN : FRAME_QUIT;
 }
 
 // ----------------------------------------------------------------------------
@@ -62,61 +231,44 @@ static void main_loop(void) {
 void game_init(void) {
     printf("portfolio-wasm starting...\n");
     
-    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-        fprintf(stderr, "SDL_Init failed: %s\n", SDL_GetError());
-        return;
-    }
-    
-    g_game.window = SDL_CreateWindow(
-        "Kashish Grover",
-        SDL_WINDOWPOS_CENTERED,
-        SDL_WINDOWPOS_CENTERED,
-        WINDOW_WIDTH,
-        WINDOW_HEIGHT,
-        SDL_WINDOW_SHOWN
-    );
-    
-    if (!g_game.window) {
-        fprintf(stderr, "SDL_CreateWindow failed: %s\n", SDL_GetError());
-        SDL_Quit();
+    if (!platform_init("Kashish Grover")) {
         return;
     }
     
-    g_game.renderer = SDL_CreateRenderer(
-        g_game.window, -1,
-        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC
-    );
-    
-    if (!g_game.renderer) {
-        fprintf(stderr, "SDL_CreateRenderer failed: %s\n", SDL_GetError());
-        SDL_DestroyWindow(g_game.window);
-        SDL_Quit();
+    // Bake all tile graphics once; the renderer draws from the atlas
+    if (!atlas_init(g_game.renderer) || !render_init()) {
+        atlas_shutdown();
+        platform_shutdown();
         return;
     }
     
     g_game.running = true;
     g_game.frame = 0;
+    g_game.alpha = 0.0f;
+    last_counter = 0;
+    accumulator = 0.0;
     
-    // Initialize rooms
+    // Initialize rooms (Home is compiled in, others load on first entry)
     rooms_init();
+    room_enter(ROOM_HOME);
     g_game.current_room = room_get_home();
+    if (!g_game.current_room) {
+        fprintf(stderr, "Failed to load the Home room\n");
+        g_game.running = false;
+        return;
+    }
+    player_spawn(g_game.current_room, 0);
     
     printf("Ready (room: %s)\n", g_game.current_room->name);
 }
 
 void game_shutdown(void) {
-    SDL_DestroyRenderer(g_game.renderer);
-    SDL_DestroyWindow(g_game.window);
-    SDL_Quit();
+    render_shutdown();
+    atlas_shutdown();
+    platform_shutdown();
 }
 
 void game_run(void) {
-#ifdef __EMSCRIPTEN__
-    emscripten_set_main_loop(main_loop, 0, 1);
-#else
-    while (g_game.running) {
-        main_loop();
-        SDL_Delay(16);
-    }
-#endif
+    if (!g_game.running) return;
+    platform_run(main_loop);
 }
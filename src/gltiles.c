@@ -0,0 +1,308 @@
+/**
+ * gltiles.c - GLES 3 / WebGL 2 tilemap renderer
+ *
+ * Room texel: R = atlas slot, G = front edge in world pixels of the
+ * furniture object on that cell (0 for anything else), the same baseline
+ * render.c's depth pass sorts on. The screen is covered by one triangle
+ * generated from gl_VertexID, so there is no vertex data at all.
+ */
+
+#include "gltiles.h"
+#include "atlas.h"
+#include "room.h"
+#include "stats.h"
+#include <GLES3/gl3.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GL_ATLAS_COLUMNS 32     // Slots per atlas texture row
+#define GL_PALETTE_MAX 32       // Size of the palette uniform
+
+#define STR_(x) #x
+#define STR(x) STR_(x)
+
+static const char *VERTEX_SHADER =
+    "#version 300 es\n"
+    "void main() {\n"
+    "    vec2 p = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));\n"
+    "    gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);\n"
+    "}\n";
+
+static const char *FRAGMENT_SHADER =
+    "#version 300 es\n"
+    "precision highp float;\n"
+    "precision highp int;\n"
+    "#define TILE_SIZE " STR(TILE_SIZE) "\n"
+    "#define PLAYER_SIZE " STR(PLAYER_SIZE) "\n"
+    "#define ATLAS_COLUMNS " STR(GL_ATLAS_COLUMNS) "\n"
+    "#define TRANSPARENT " STR(ATLAS_TRANSPARENT) "u\n"
+    "uniform highp usampler2D u_atlas;\n"
+    "uniform highp usampler2D u_player;\n"
+    "uniform highp usampler2D u_rooms[2];\n"
+    "uniform ivec2 u_size[2];       // Room size in pixels\n"
+    "uniform ivec2 u_camera[2];\n"
+    "uniform ivec3 u_actor[2];      // Player top-left, and whether drawn\n"
+    "uniform int u_current;         // Index of the room on screen\n"
+    "uniform float u_fade;\n"
+    "uniform int u_screen_h;\n"
+    "uniform vec3 u_palette[" STR(GL_PALETTE_MAX) "];\n"
+    "out vec4 color;\n"
+    "\n"
+    "uint room_pixel(highp usampler2D room, ivec2 size, ivec2 world, ivec3 actor) {\n"
+    "    uint index = 0u;\n"
+    "    int front = 0;\n"
+    "    if (all(greaterThanEqual(world, ivec2(0))) && all(lessThan(world, size))) {\n"
+    "        uvec2 cell = texelFetch(room, world / TILE_SIZE, 0).rg;\n"
+    "        int slot = int(cell.r);\n"
+    "        ivec2 at = ivec2(slot % ATLAS_COLUMNS, slot / ATLAS_COLUMNS) * TILE_SIZE;\n"
+    "        index = texelFetch(u_atlas, at + world % TILE_SIZE, 0).r;\n"
+    "        front = int(cell.g);\n"
+    "    }\n"
+    "    ivec2 p = world - actor.xy;\n"
+    "    if (actor.z != 0 && all(greaterThanEqual(p, ivec2(0))) &&\n"
+    "        all(lessThan(p, ivec2(PLAYER_SIZE))) && front <= actor.y + PLAYER_SIZE) {\n"
+    "        uint sprite = texelFetch(u_player, p, 0).r;\n"
+    "        if (sprite != TRANSPARENT) index = sprite;\n"
+    "    }\n"
+    "    return index;\n"
+    "}\n"
+    "\n"
+    "void main() {\n"
+    "    ivec2 screen = ivec2(int(gl_FragCoord.x), u_screen_h - 1 - int(gl_FragCoord.y));\n"
+    "    vec3 rgb;\n"
+    "    // Sampler arrays only take constant indices, hence the branches\n"
+    "    if (u_current == 0) {\n"
+    "        rgb = u_palette[room_pixel(u_rooms[0], u_size[0], screen + u_camera[0], u_actor[0])];\n"
+    "        if (u_fade > 0.0) rgb = mix(rgb, u_palette[room_pixel(u_rooms[1], u_size[1],\n"
+    "                                    screen + u_camera[1], u_actor[1])], u_fade);\n"
+    "    } else {\n"
+    "        rgb = u_palette[room_pixel(u_rooms[1], u_size[1], screen + u_camera[1], u_actor[1])];\n"
+    "        if (u_fade > 0.0) rgb = mix(rgb, u_palette[room_pixel(u_rooms[0], u_size[0],\n"
+    "                                    screen + u_camera[0], u_actor[0])], u_fade);\n"
+    "    }\n"
+    "    color = vec4(rgb, 1.0);\n"
+    "}\n";
+
+// Each room texture remembers what it was last drawn with, so the one
+// being faded out keeps drawing exactly as it was last seen
+typedef struct {
+    GLuint texture;
+    SDL_Point size;             // Room size in pixels
+    SDL_Point camera;
+    SDL_Point actor;
+    bool has_actor;
+} RoomTexture;
+
+static GLuint program = 0;
+static GLuint vertex_array = 0;
+static GLuint tile_texture = 0;
+static GLuint sprite_texture = 0;
+static RoomTexture rooms[2];
+static int current = 0;
+static GLint u_size, u_camera, u_actor, u_current, u_fade;
+
+// Upload staging: two 16-bit channels per tile
+static uint16_t cells[ROOM_MAX_WIDTH * ROOM_MAX_HEIGHT * 2];
+
+static GLuint compile(GLenum type, const char *source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+    GLint ok = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        char log[1024];
+        glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+        fprintf(stderr, "gltiles: shader does not compile:\n%s\n", log);
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+static bool build_program(void) {
+    GLuint vs = compile(GL_VERTEX_SHADER, VERTEX_SHADER);
+    GLuint fs = compile(GL_FRAGMENT_SHADER, FRAGMENT_SHADER);
+    if (vs && fs) {
+        program = glCreateProgram();
+        glAttachShader(program, vs);
+        glAttachShader(program, fs);
+        glLinkProgram(program);
+    }
+    if (vs) glDeleteShader(vs);
+    if (fs) glDeleteShader(fs);
+    if (!program) return false;
+
+    GLint ok = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        char log[1024];
+        glGetProgramInfoLog(program, sizeof(log), NULL, log);
+        fprintf(stderr, "gltiles: program does not link:\n%s\n", log);
+        return false;
+    }
+    return true;
+}
+
+static GLuint create_texture(GLenum format, int w, int h) {
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, format, w, h);
+    // Integer textures are only complete with NEAREST filtering
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    return texture;
+}
+
+// Slots in a grid of GL_ATLAS_COLUMNS, one palette index per texel
+static bool upload_atlas(void) {
+    int slots = atlas_slot_count();
+    int w = GL_ATLAS_COLUMNS * TILE_SIZE;
+    int h = (slots + GL_ATLAS_COLUMNS - 1) / GL_ATLAS_COLUMNS * TILE_SIZE;
+    uint8_t *pixels = calloc((size_t)w * h, 1);
+    if (!pixels) {
+        fprintf(stderr, "gltiles: out of memory\n");
+        return false;
+    }
+    for (int s = 0; s < slots; s++) {
+        const uint8_t *bitmap = atlas_slot_bitmap(s);
+        int x = s % GL_ATLAS_COLUMNS * TILE_SIZE, y = s / GL_ATLAS_COLUMNS * TILE_SIZE;
+        for (int row = 0; row < TILE_SIZE; row++) {
+            memcpy(&pixels[(y + row) * w + x], &bitmap[row * TILE_SIZE], TILE_SIZE);
+        }
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    tile_texture = create_texture(GL_R8UI, w, h);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, w, h, GL_RED_INTEGER, GL_UNSIGNED_BYTE, pixels);
+    free(pixels);
+
+    sprite_texture = create_texture(GL_R8UI, PLAYER_SIZE, PLAYER_SIZE);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, PLAYER_SIZE, PLAYER_SIZE, GL_RED_INTEGER,
+                    GL_UNSIGNED_BYTE, atlas_player_bitmap());
+    return true;
+}
+
+bool gl_tiles_init(void) {
+    gl_tiles_shutdown();
+    int colors;
+    const Color *palette = atlas_palette(&colors);
+    if (colors > GL_PALETTE_MAX) {
+        fprintf(stderr, "gltiles: %d atlas colors, the palette uniform holds %d\n",
+                colors, GL_PALETTE_MAX);
+        return false;
+    }
+    if (!build_program() || !upload_atlas()) {
+        gl_tiles_shutdown();
+        return false;
+    }
+    for (int i = 0; i < 2; i++) {
+        rooms[i] = (RoomTexture){0};
+        rooms[i].texture = create_texture(GL_RG16UI, ROOM_MAX_WIDTH, ROOM_MAX_HEIGHT);
+    }
+    current = 0;
+    glGenVertexArrays(1, &vertex_array);
+
+    // Fixed for the program's lifetime: texture units, palette, screen
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "u_atlas"), 0);
+    glUniform1i(glGetUniformLocation(program, "u_player"), 1);
+    GLint units[2] = {2, 3};
+    glUniform1iv(glGetUniformLocation(program, "u_rooms"), 2, units);
+    glUniform1i(glGetUniformLocation(program, "u_screen_h"), WINDOW_HEIGHT);
+    float rgb[GL_PALETTE_MAX * 3] = {0};
+    for (int i = 0; i < colors; i++) {
+        rgb[i * 3] = palette[i].r / 255.0f;
+        rgb[i * 3 + 1] = palette[i].g / 255.0f;
+        rgb[i * 3 + 2] = palette[i].b / 255.0f;
+    }
+    glUniform3fv(glGetUniformLocation(program, "u_palette"), GL_PALETTE_MAX, rgb);
+    u_size = glGetUniformLocation(program, "u_size");
+    u_camera = glGetUniformLocation(program, "u_camera");
+    u_actor = glGetUniformLocation(program, "u_actor");
+    u_current = glGetUniformLocation(program, "u_current");
+    u_fade = glGetUniformLocation(program, "u_fade");
+
+    if (glGetError() != GL_NO_ERROR) {
+        fprintf(stderr, "gltiles: GL setup failed\n");
+        gl_tiles_shutdown();
+        return false;
+    }
+    return true;
+}
+
+void gl_tiles_shutdown(void) {
+    if (program) glDeleteProgram(program);
+    if (vertex_array) glDeleteVertexArrays(1, &vertex_array);
+    GLuint textures[4] = {tile_texture, sprite_texture, rooms[0].texture, rooms[1].texture};
+    for (int i = 0; i < 4; i++) {
+        if (textures[i]) glDeleteTextures(1, &textures[i]);
+    }
+    program = vertex_array = tile_texture = sprite_texture = 0;
+    memset(rooms, 0, sizeof(rooms));
+}
+
+void gl_tiles_upload(const Room *room, TileRect rect) {
+    if (rect.w <= 0 || rect.h <= 0) return;
+    uint16_t *cell = cells;
+    for (int y = rect.y; y < rect.y + rect.h; y++) {
+        for (int x = rect.x; x < rect.x + rect.w; x++) {
+            const Tile *tile = room_tile(room, x, y);
+            int front = 0;
+            if (tile_is_sprite((TileType)tile->type)) {
+                const RoomObject *obj = &room->objects[tile->variant];
+                front = (obj->y + obj->h) * TILE_SIZE;
+            }
+            *cell++ = (uint16_t)atlas_tile_slot((TileType)tile->type, room_tile_variant(room, x, y));
+            *cell++ = (uint16_t)front;
+        }
+    }
+    glBindTexture(GL_TEXTURE_2D, rooms[current].texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.w, rect.h, GL_RG_INTEGER,
+                    GL_UNSIGNED_SHORT, cells);
+    g_frame_stats.tiles += (uint32_t)(rect.w * rect.h);
+    g_frame_stats.draw_calls++;
+}
+
+void gl_tiles_begin_fade(void) {
+    current ^= 1;
+}
+
+void gl_tiles_draw(const Room *room, SDL_Point camera, const SDL_Point *player, float fade) {
+    RoomTexture *r = &rooms[current];
+    r->size = (SDL_Point){room->width * TILE_SIZE, room->height * TILE_SIZE};
+    r->camera = camera;
+    r->has_actor = player != NULL;
+    if (player) r->actor = *player;
+
+    GLint size[4], cam[4], actor[6];
+    for (int i = 0; i < 2; i++) {
+        size[i * 2] = rooms[i].size.x;
+        size[i * 2 + 1] = rooms[i].size.y;
+        cam[i * 2] = rooms[i].camera.x;
+        cam[i * 2 + 1] = rooms[i].camera.y;
+        actor[i * 3] = rooms[i].actor.x;
+        actor[i * 3 + 1] = rooms[i].actor.y;
+        actor[i * 3 + 2] = rooms[i].has_actor;
+    }
+
+    glViewport(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+    glUseProgram(program);
+    glUniform2iv(u_size, 2, size);
+    glUniform2iv(u_camera, 2, cam);
+    glUniform3iv(u_actor, 2, actor);
+    glUniform1i(u_current, current);
+    glUniform1f(u_fade, fade);
+    GLuint textures[4] = {tile_texture, sprite_texture, rooms[0].texture, rooms[1].texture};
+    for (int i = 0; i < 4; i++) {
+        glActiveTexture(GL_TEXTURE0 + i);
+        glBindTexture(GL_TEXTURE_2D, textures[i]);
+    }
+    glActiveTexture(GL_TEXTURE0);
+    glBindVertexArray(vertex_array);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    g_frame_stats.draw_calls++;
+}
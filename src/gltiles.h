@@ -0,0 +1,36 @@
+/**
+ * gltiles.h - GLES 3 / WebGL 2 tilemap renderer (RENDER_GL backend)
+ *
+ * The room is a small integer texture, one texel per tile, and the atlas
+ * another, one palette index per pixel. A fragment shader looks every
+ * screen pixel up through both and the palette uniform, so a frame is one
+ * draw call whatever the room holds. The player is drawn by the same pass,
+ * behind any furniture cell whose front edge is below the player's.
+ *
+ * Needs a current GLES 3.0 (or WebGL 2) context; it does not create one,
+ * so the game (SDL) and the headless bench (EGL) share it.
+ */
+
+#ifndef GLTILES_H
+#define GLTILES_H
+
+#include "game.h"
+
+// Build the program and textures from the atlas (after atlas_init)
+bool gl_tiles_init(void);
+void gl_tiles_shutdown(void);
+
+// Copy a rect of a room's tiles to the room texture; the first upload
+// for a room must cover all of it
+void gl_tiles_upload(const Room *room, TileRect rect);
+
+// Keep the room texture, camera and player of the last draw as the room
+// being faded out; uploads go to the other room texture from here on
+void gl_tiles_begin_fade(void);
+
+// Draw the screen: the room with the camera (world pixel at the top-left)
+// and the player's sprite at a world position (NULL: none). fade is the
+// share of the frame from gl_tiles_begin_fade() mixed in, 0 for none.
+void gl_tiles_draw(const Room *room, SDL_Point camera, const SDL_Point *player, float fade);
+
+#endif // GLTILES_H
@@ -0,0 +1,91 @@
+/**
+ * platform.h - Window, input, frame presentation and main loop
+ *
+ * Everything the game needs from the host goes through here.
+ * platform_sdl.c implements it with SDL2 (native, and the default web
+ * build). platform_html5.c uses Emscripten's html5.h and a 2D canvas
+ * directly, so that web build links no SDL at all (make PLATFORM=html5,
+ * software renderer only).
+ */
+
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+#ifdef PLATFORM_HTML5
+#include <stdbool.h>
+#include <stdint.h>
+
+// No SDL in this build. The geometry types shared with the SDL backends
+// keep their names and layout; SDL handles in interfaces stay opaque.
+typedef struct { int x, y; } SDL_Point;
+typedef struct { int x, y, w, h; } SDL_Rect;
+typedef struct SDL_Window SDL_Window;
+typedef struct SDL_Renderer SDL_Renderer;
+typedef struct SDL_Texture SDL_Texture;
+#else
+#include <SDL2/SDL.h>
+#endif
+
+#include "world.h"
+
+// Movement keys held (arrows or WASD), see platform_input()
+#define INPUT_LEFT  0x01
+#define INPUT_RIGHT 0x02
+#define INPUT_UP    0x04
+#define INPUT_DOWN  0x08
+
+// What happened since the last platform_poll()
+#define EVENT_ANY           0x01    // Any event at all (key, window, quit...)
+#define EVENT_QUIT          0x02    // Window closed or Escape
+#define EVENT_TOGGLE_HUD    0x04    // F3
+#define EVENT_TARGETS_RESET 0x08    // Render target contents were lost
+#define EVENT_DEVICE_RESET  0x10    // Every texture was lost
+
+// What a frame callback did, for platform_run()
+typedef enum {
+    FRAME_DRAWN,        // Keep the display rate
+    FRAME_BUSY,         // Worked but presented nothing: the loop paces it
+    FRAME_IDLE,         // Nothing to do: the loop may sleep until input
+    FRAME_QUIT
+} FrameResult;
+
+// Open the WINDOW_WIDTH×WINDOW_HEIGHT window (and, with SDL, set
+// g_game.window and g_game.renderer; RENDER_GL gets no renderer, the
+// backend creates its own GLES 3 context)
+bool platform_init(const char *title);
+void platform_shutdown(void);
+
+// Drain pending events into EVENT_* bits
+uint32_t platform_poll(void);
+
+// INPUT_* bits for the keys held right now
+uint32_t platform_input(void);
+
+// Monotonic clock, platform_tick_rate() ticks per second
+uint64_t platform_ticks(void);
+uint64_t platform_tick_rate(void);
+
+// Software framebuffer output. Pixels are WINDOW_WIDTH per row in the
+// platform's own format (see platform_rgb). platform_fb_update() takes the
+// regions that changed and puts the whole frame on screen, under anything
+// drawn after it (the SDL HUD).
+uint32_t platform_rgb(Color color);
+bool platform_fb_init(void);
+void platform_fb_shutdown(void);
+void platform_fb_update(const uint32_t *pixels, const SDL_Rect *rects, int count);
+
+#ifdef PLATFORM_HTML5
+// Fill rects over the frame on screen, blended by alpha (0 clears them);
+// how the HUD is drawn without an SDL_Renderer (cmdbuf.c)
+void platform_fill_rects(const SDL_Rect *rects, int count, Color color, uint8_t alpha);
+#endif
+
+// Show the frame drawn since the last present
+void platform_present(void);
+
+// Call frame() once per display frame. Native builds return once it
+// gives FRAME_QUIT; on the web the page keeps the loop and this does not
+// return.
+void platform_run(FrameResult (*frame)(void));
+
+#endif // PLATFORM_H
@@ -0,0 +1,277 @@
+/**
+ * platform_html5.c - Web platform layer without SDL (PLATFORM=html5)
+ *
+ * Keyboard state comes from html5.h callbacks and the software framebuffer
+ * goes to the page's 2D canvas with putImageData(), one call per changed
+ * region. The canvas keeps its pixels between frames, so presenting is a
+ * no-op. There is no SDL_Renderer; the F3 HUD is filled on the canvas over
+ * the frame (platform_fill_rects), and shell.html reads the stats buffer.
+ *
+ * With PLATFORM_WORKER the module runs in a dedicated worker (worker.js)
+ * and Module.canvas is an OffscreenCanvas the page transferred to it.
+ * Workers get no DOM events, so the page (worker-host.js) writes key
+ * changes, F3 and Escape to Module.inputRing, drained here once per frame.
+ */
+
+#include "platform.h"
+#include "game.h"
+#include "stats.h"
+#include <emscripten.h>
+#include <emscripten/html5.h>
+#include <stdio.h>
+#include <string.h>
+
+static uint32_t events = 0;     // EVENT_* since the last platform_poll()
+static uint32_t held = 0;       // INPUT_* keys down
+
+// ----------------------------------------------------------------------------
+// Canvas
+// ----------------------------------------------------------------------------
+
+// The context is kept on Module; the ImageData is a view of wasm memory,
+// made per frame because memory growth replaces the buffer under it.
+// ImageData cannot view shared memory (RENDER_THREADS builds), so there the
+// changed rows are copied into an ImageData of its own, kept on Module.
+EM_JS(int, canvas_init, (int width, int height), {
+    var canvas = Module['canvas'];
+    if (!canvas) return 0;  // Or an OffscreenCanvas, with PLATFORM_WORKER
+    canvas.width = width;
+    canvas.height = height;
+    Module['canvasContext'] = canvas.getContext('2d', {alpha: false});
+    return Module['canvasContext'] ? 1 : 0;
+});
+
+EM_JS(void, canvas_put, (const uint32_t *pixels, const SDL_Rect *rects, int count,
+                         int width, int height), {
+    var shared = !(HEAPU8.buffer instanceof ArrayBuffer);
+    var image = shared ? Module['canvasImage'] || (Module['canvasImage'] = new ImageData(width, height)) :
+        new ImageData(new Uint8ClampedArray(HEAPU8.buffer, pixels, width * height * 4),
+                      width, height);
+    var ctx = Module['canvasContext'];
+    for (var i = 0; i < count; i++) {
+        var r = (rects >> 2) + i * 4;
+        var x = HEAP32[r], y = HEAP32[r + 1], w = HEAP32[r + 2], h = HEAP32[r + 3];
+        for (var row = y; shared && row < y + h; row++) {
+            var at = (row * width + x) * 4;
+            image.data.set(HEAPU8.subarray(pixels + at, pixels + at + w * 4), at);
+        }
+        ctx.putImageData(image, 0, 0, x, y, w, h);
+    }
+});
+
+EM_JS(void, canvas_fill, (const SDL_Rect *rects, int count, int r, int g, int b, int alpha), {
+    var ctx = Module['canvasContext'];
+    ctx.globalAlpha = alpha / 255;
+    ctx.fillStyle = 'rgb(' + r + ',' + g + ',' + b + ')';
+    for (var i = 0; i < count; i++) {
+        var at = (rects >> 2) + i * 4;
+        if (alpha) ctx.fillRect(HEAP32[at], HEAP32[at + 1], HEAP32[at + 2], HEAP32[at + 3]);
+        else ctx.clearRect(HEAP32[at], HEAP32[at + 1], HEAP32[at + 2], HEAP32[at + 3]);
+    }
+    ctx.globalAlpha = 1;
+});
+
+// ----------------------------------------------------------------------------
+// Input
+// ----------------------------------------------------------------------------
+
+#ifdef PLATFORM_WORKER
+
+// Ring layout, shared with worker-host.js: [0] entries written, [1]
+// entries read, then INPUT_RING_SIZE entries of kind << 8 | INPUT_* bits.
+// Shared memory if the page is cross-origin isolated; otherwise worker.js
+// fills it from postMessage. Either way the page never waits on the game.
+#define INPUT_RING_SIZE 64
+#define INPUT_KEY_DOWN 1
+#define INPUT_KEY_UP 2
+#define INPUT_RELEASE_ALL 3     // Page lost focus or was hidden
+#define INPUT_EVENT 4           // EVENT_QUIT (Escape) or EVENT_TOGGLE_HUD (F3)
+
+EM_JS(int, input_drain, (uint32_t *out, int max), {
+    var ring = Module['inputRing'];
+    var read = Atomics.load(ring, 1), written = Atomics.load(ring, 0);
+    var n = 0;
+    for (; read !== written && n < max; read = (read + 1) | 0, n++) {
+        HEAPU32[(out >> 2) + n] = Atomics.load(ring, 2 + (read & 63));
+    }
+    Atomics.store(ring, 1, read);
+    return n;
+});
+
+_Static_assert(INPUT_RING_SIZE == 64, "input_drain() masks with 63");
+
+static void drain_input(void) {
+    uint32_t entries[INPUT_RING_SIZE];
+    int count = input_drain(entries, INPUT_RING_SIZE);
+    for (int i = 0; i < count; i++) {
+        uint32_t bits = entries[i] & 0xFF;
+        switch (entries[i] >> 8) {
+            case INPUT_KEY_DOWN: held |= bits; break;
+            case INPUT_KEY_UP: held &= ~bits; break;
+            case INPUT_RELEASE_ALL: held = 0; break;
+            case INPUT_EVENT: events |= bits & (EVENT_QUIT | EVENT_TOGGLE_HUD); break;
+        }
+        events |= EVENT_ANY;
+    }
+}
+
+// Keys held when the game last stopped are not held now
+bool platform_init(const char *title) {
+    (void)title;    // A worker has no document to name
+    held = 0;
+    events = 0;
+    if (!canvas_init(WINDOW_WIDTH, WINDOW_HEIGHT)) {
+        fprintf(stderr, "platform: no OffscreenCanvas (Module.canvas)\n");
+        return false;
+    }
+    return true;
+}
+
+void platform_shutdown(void) {
+}
+
+uint32_t platform_poll(void) {
+    drain_input();
+    uint32_t seen = events;
+    events = 0;
+    return seen;
+}
+
+#else
+
+// KeyboardEvent.code to INPUT_* (arrows or WASD, whatever the layout)
+static uint32_t key_bit(const char *code) {
+    if (!strcmp(code, "ArrowLeft") || !strcmp(code, "KeyA")) return INPUT_LEFT;
+    if (!strcmp(code, "ArrowRight") || !strcmp(code, "KeyD")) return INPUT_RIGHT;
+    if (!strcmp(code, "ArrowUp") || !strcmp(code, "KeyW")) return INPUT_UP;
+    if (!strcmp(code, "ArrowDown") || !strcmp(code, "KeyS")) return INPUT_DOWN;
+    return 0;
+}
+
+// Movement keys are consumed so the arrows do not scroll the page, and F3
+// so it does not open the browser's find bar; Escape still reaches it
+static EM_BOOL on_key(int type, const EmscriptenKeyboardEvent *event, void *data) {
+    (void)data;
+    events |= EVENT_ANY;
+    bool down = type == EMSCRIPTEN_EVENT_KEYDOWN;
+    bool hud = !strcmp(event->code, "F3");
+    if (down && !strcmp(event->code, "Escape")) events |= EVENT_QUIT;
+    if (down && hud && !event->repeat) events |= EVENT_TOGGLE_HUD;
+    uint32_t bit = key_bit(event->code);
+    if (down) held |= bit;
+    else held &= ~bit;
+    return bit != 0 || hud;
+}
+
+// Keys released while the page is in the background never send keyup
+static EM_BOOL on_blur(int type, const EmscriptenFocusEvent *event, void *data) {
+    (void)type;
+    (void)event;
+    (void)data;
+    events |= EVENT_ANY;
+    held = 0;
+    return 0;
+}
+
+// Hidden tabs can lose keyups without a blur (switching tabs by shortcut)
+static EM_BOOL on_visibility(int type, const EmscriptenVisibilityChangeEvent *event,
+                             void *data) {
+    (void)type;
+    (void)data;
+    if (event->hidden) {
+        events |= EVENT_ANY;
+        held = 0;
+    }
+    return 0;
+}
+
+// Keys held when the game last stopped are not held now
+bool platform_init(const char *title) {
+    held = 0;
+    events = 0;
+    emscripten_set_window_title(title);
+    if (!canvas_init(WINDOW_WIDTH, WINDOW_HEIGHT)) {
+        fprintf(stderr, "platform: no 2D canvas (Module.canvas)\n");
+        return false;
+    }
+    const char *target = EMSCRIPTEN_EVENT_TARGET_WINDOW;
+    emscripten_set_keydown_callback(target, NULL, 1, on_key);
+    emscripten_set_keyup_callback(target, NULL, 1, on_key);
+    emscripten_set_blur_callback(target, NULL, 1, on_blur);
+    emscripten_set_visibilitychange_callback(NULL, 1, on_visibility);
+    return true;
+}
+
+void platform_shutdown(void) {
+    emscripten_html5_remove_all_event_listeners();
+}
+
+uint32_t platform_poll(void) {
+    uint32_t seen = events;
+    events = 0;
+    return seen;
+}
+
+#endif // PLATFORM_WORKER
+
+uint32_t platform_input(void) {
+    return held;
+}
+
+// ----------------------------------------------------------------------------
+// Time
+// ----------------------------------------------------------------------------
+
+// performance.now() in microseconds
+uint64_t platform_ticks(void) {
+    return (uint64_t)(emscripten_get_now() * 1000.0);
+}
+
+uint64_t platform_tick_rate(void) {
+    return 1000000;
+}
+
+// ----------------------------------------------------------------------------
+// Output
+// ----------------------------------------------------------------------------
+
+// ImageData is RGBA bytes, so 0xAABBGGRR on little-endian wasm
+uint32_t platform_rgb(Color color) {
+    return 0xFF000000u | (uint32_t)color.b << 16 | (uint32_t)color.g << 8 | color.r;
+}
+
+bool platform_fb_init(void) {
+    return true;
+}
+
+void platform_fb_shutdown(void) {
+}
+
+void platform_fb_update(const uint32_t *pixels, const SDL_Rect *rects, int count) {
+    canvas_put(pixels, rects, count, WINDOW_WIDTH, WINDOW_HEIGHT);
+    g_frame_stats.draw_calls += (uint32_t)count;
+}
+
+void platform_fill_rects(const SDL_Rect *rects, int count, Color color, uint8_t alpha) {
+    canvas_fill(rects, count, color.r, color.g, color.b, alpha);
+}
+
+void platform_present(void) {
+}
+
+// ----------------------------------------------------------------------------
+// Main loop
+// ----------------------------------------------------------------------------
+
+static FrameResult (*frame_fn)(void) = NULL;
+
+static void web_frame(void) {
+    frame_fn();
+}
+
+// requestAnimationFrame pacing; idle frames cost one poll of the flags
+// above. There is nothing to quit to, so FRAME_QUIT is ignored.
+void platform_run(FrameResult (*frame)(void)) {
+    frame_fn = frame;
+    emscripten_set_main_loop(web_frame, 0, 1);
+}
@@ -0,0 +1,264 @@
+/**
+ * platform_sdl.c - SDL2 platform layer (native, and the default web build)
+ */
+
+#include "platform.h"
+#include "game.h"
+#include "stats.h"
+#include <stdio.h>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif
+
+// Native builds block on the event queue when idle, waking at least every
+// IDLE_WAIT_MS for timers and animation
+#define IDLE_WAIT_MS 250
+
+static SDL_Texture *fb_texture = NULL;  // Streaming copy of the framebuffer
+
+// ----------------------------------------------------------------------------
+// Window
+// ----------------------------------------------------------------------------
+
+bool platform_init(const char *title) {
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        fprintf(stderr, "SDL_Init failed: %s\n", SDL_GetError());
+        return false;
+    }
+
+#ifdef RENDER_GL
+    // The GL backend draws through its own GLES 3 (WebGL 2) context, so
+    // the window gets no SDL_Renderer
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_ES);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 0);
+    Uint32 window_flags = SDL_WINDOW_SHOWN | SDL_WINDOW_OPENGL;
+#else
+    Uint32 window_flags = SDL_WINDOW_SHOWN;
+#endif
+
+    g_game.window = SDL_CreateWindow(
+        title,
+        SDL_WINDOWPOS_CENTERED,
+        SDL_WINDOWPOS_CENTERED,
+        WINDOW_WIDTH,
+        WINDOW_HEIGHT,
+        window_flags
+    );
+
+    if (!g_game.window) {
+        fprintf(stderr, "SDL_CreateWindow failed: %s\n", SDL_GetError());
+        SDL_Quit();
+        return false;
+    }
+
+#ifndef RENDER_GL
+    g_game.renderer = SDL_CreateRenderer(
+        g_game.window, -1,
+        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC
+    );
+
+    if (!g_game.renderer) {
+        fprintf(stderr, "SDL_CreateRenderer failed: %s\n", SDL_GetError());
+        SDL_DestroyWindow(g_game.window);
+        g_game.window = NULL;
+        SDL_Quit();
+        return false;
+    }
+#endif
+    return true;
+}
+
+void platform_shutdown(void) {
+    if (g_game.renderer) SDL_DestroyRenderer(g_game.renderer);
+    if (g_game.window) SDL_DestroyWindow(g_game.window);
+    g_game.renderer = NULL;
+    g_game.window = NULL;
+    SDL_Quit();
+}
+
+// ----------------------------------------------------------------------------
+// Input
+// ----------------------------------------------------------------------------
+
+uint32_t platform_poll(void) {
+    uint32_t events = 0;
+    SDL_Event event;
+    while (SDL_PollEvent(&event)) {
+        events |= EVENT_ANY;
+        switch (event.type) {
+            case SDL_QUIT:
+                events |= EVENT_QUIT;
+                break;
+            case SDL_KEYDOWN:
+                if (event.key.keysym.sym == SDLK_ESCAPE) {
+                    events |= EVENT_QUIT;
+                } else if (event.key.keysym.sym == SDLK_F3 && !event.key.repeat) {
+                    events |= EVENT_TOGGLE_HUD;
+                }
+                break;
+            case SDL_RENDER_TARGETS_RESET:
+                events |= EVENT_TARGETS_RESET;
+                break;
+            case SDL_RENDER_DEVICE_RESET:
+                events |= EVENT_DEVICE_RESET;
+                break;
+        }
+    }
+    return events;
+}
+
+uint32_t platform_input(void) {
+    const Uint8 *keys = SDL_GetKeyboardState(NULL);
+    uint32_t input = 0;
+    if (keys[SDL_SCANCODE_LEFT] || keys[SDL_SCANCODE_A]) input |= INPUT_LEFT;
+    if (keys[SDL_SCANCODE_RIGHT] || keys[SDL_SCANCODE_D]) input |= INPUT_RIGHT;
+    if (keys[SDL_SCANCODE_UP] || keys[SDL_SCANCODE_W]) input |= INPUT_UP;
+    if (keys[SDL_SCANCODE_DOWN] || keys[SDL_SCANCODE_S]) input |= INPUT_DOWN;
+    return input;
+}
+
+// ----------------------------------------------------------------------------
+// Time
+// ----------------------------------------------------------------------------
+
+uint64_t platform_ticks(void) {
+    return SDL_GetPerformanceCounter();
+}
+
+uint64_t platform_tick_rate(void) {
+    return SDL_GetPerformanceFrequency();
+}
+
+// ----------------------------------------------------------------------------
+// Output
+// ----------------------------------------------------------------------------
+
+uint32_t platform_rgb(Color color) {
+    return 0xFF000000u | (uint32_t)color.r << 16 | (uint32_t)color.g << 8 | color.b;
+}
+
+bool platform_fb_init(void) {
+    fb_texture = SDL_CreateTexture(g_game.renderer, SDL_PIXELFORMAT_ARGB8888,
+                                   SDL_TEXTUREACCESS_STREAMING,
+                                   WINDOW_WIDTH, WINDOW_HEIGHT);
+    if (!fb_texture) {
+        fprintf(stderr, "fb: SDL_CreateTexture failed: %s\n", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+void platform_fb_shutdown(void) {
+    if (fb_texture) {
+        SDL_DestroyTexture(fb_texture);
+        fb_texture = NULL;
+    }
+}
+
+// The backbuffer is not kept between frames, so the whole texture is
+// copied every time; only the changed regions are uploaded to it
+void platform_fb_update(const uint32_t *pixels, const SDL_Rect *rects, int count) {
+    for (int i = 0; i < count; i++) {
+        const SDL_Rect *r = &rects[i];
+        SDL_UpdateTexture(fb_texture, r, &pixels[r->y * WINDOW_WIDTH + r->x],
+                          WINDOW_WIDTH * sizeof(uint32_t));
+    }
+    SDL_RenderCopy(g_game.renderer, fb_texture, NULL, NULL);
+    g_frame_stats.draw_calls += (uint32_t)count + 1;
+}
+
+void platform_present(void) {
+#ifdef RENDER_GL
+    SDL_GL_SwapWindow(g_game.window);
+#else
+    SDL_RenderPresent(g_game.renderer);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Main loop
+// ----------------------------------------------------------------------------
+
+#ifdef __EMSCRIPTEN__
+
+static FrameResult (*frame_fn)(void) = NULL;
+
+static void web_frame(void) {
+    frame_fn();
+}
+
+// requestAnimationFrame pacing. Idle frames return right after polling
+// input, so an idle page costs one event poll per animation frame (and
+// none in a hidden tab).
+void platform_run(FrameResult (*frame)(void)) {
+    frame_fn = frame;
+    emscripten_set_main_loop(web_frame, 0, 1);
+}
+
+#else
+
+// Whether presenting waits for the display's refresh (the SDL_Renderer was
+// created with PRESENTVSYNC, or the GL backend got a swap interval)
+static bool present_waits(void) {
+#ifdef RENDER_GL
+    return SDL_GL_GetSwapInterval() != 0;
+#else
+    SDL_RendererInfo info;
+    return SDL_GetRendererInfo(g_game.renderer, &info) == 0 &&
+           (info.flags & SDL_RENDERER_PRESENTVSYNC);
+#endif
+}
+
+// Sleep until about a performance-counter deadline: SDL_Delay() to within
+// a millisecond of it, which OS timers may overshoot, then one yield
+static void wait_until(uint64_t deadline) {
+    uint64_t freq = SDL_GetPerformanceFrequency();
+    uint64_t now = SDL_GetPerformanceCounter();
+    if (now >= deadline) return;
+    uint64_t ms = (deadline - now) * 1000 / freq;
+    if (ms > 1) SDL_Delay((Uint32)(ms - 1));
+    SDL_Delay(0);
+}
+
+// Refresh rate of the window's display, or UPDATE_HZ if it is unknown
+static int display_hz(void) {
+    SDL_DisplayMode mode;
+    if (SDL_GetWindowDisplayMode(g_game.window, &mode) != 0 || mode.refresh_rate <= 0) {
+        return UPDATE_HZ;
+    }
+    return mode.refresh_rate;
+}
+
+// With vsync, presenting paces drawn frames at the display's rate and the
+// simulation keeps its own step through g_game.alpha. Without it, frames
+// are held to UPDATE_HZ here, as are frames that presented nothing
+// (FRAME_BUSY) either way. Drawn vsync frames still get a floor a quarter
+// faster than the display: a real vblank wait always outlasts it, and it
+// stops the loop spinning when present stops waiting (a minimized or
+// occluded window).
+void platform_run(FrameResult (*frame)(void)) {
+    bool vsync = present_waits();
+    uint64_t freq = SDL_GetPerformanceFrequency();
+    uint64_t period = freq / UPDATE_HZ;
+    uint64_t vsync_floor = freq * 4 / ((uint64_t)display_hz() * 5);
+    uint64_t next = SDL_GetPerformanceCounter();
+    for (;;) {
+        FrameResult result = frame();
+        if (result == FRAME_QUIT) return;
+        if (result == FRAME_IDLE) {
+            // Leaves the event queued for the next frame
+            SDL_WaitEventTimeout(NULL, IDLE_WAIT_MS);
+            next = SDL_GetPerformanceCounter();
+            continue;
+        }
+        uint64_t step = vsync && result == FRAME_DRAWN ? vsync_floor : period;
+        next += step;
+        uint64_t now = SDL_GetPerformanceCounter();
+        if (now > next + step) next = now;  // Fell behind; don't burst
+        wait_until(next);
+    }
+}
+
+#endif
@@ -0,0 +1,139 @@
+/**
+ * pool.c - Worker threads for the software renderer (RENDER_THREADS)
+ *
+ * Workers sleep on a condition variable between jobs. pool_run() publishes
+ * a job under the lock, wakes them, takes items itself, then waits for
+ * every worker to leave the job before returning, so the next job never
+ * overlaps a late finisher of this one.
+ */
+
+#include "pool.h"
+
+#if defined(RENDER_THREADS) && RENDER_THREADS > 1
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#ifdef __EMSCRIPTEN__
+#include <emscripten/threading.h>
+#else
+#include <unistd.h>
+#endif
+
+#define MAX_WORKERS (RENDER_THREADS - 1)
+
+static pthread_t workers[MAX_WORKERS];
+static int worker_count = 0;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake = PTHREAD_COND_INITIALIZER;
+static unsigned generation = 0;     // Bumped for each job, under the lock
+static bool stopping = false;
+
+// The job in progress; set under the lock before the workers are woken
+static void (*job_fn)(void *ctx, int index);
+static void *job_ctx;
+static int job_count;
+static atomic_int next_item;        // Next index to take
+static atomic_int busy;             // Workers still in the job
+
+static void take_items(void) {
+    for (int i; (i = atomic_fetch_add(&next_item, 1)) < job_count;) {
+        job_fn(job_ctx, i);
+    }
+}
+
+// arg is the generation when the pool started: jobs from before a restart
+// are done, and one published before this thread first takes the lock is not
+static void *worker_main(void *arg) {
+    unsigned seen = (unsigned)(uintptr_t)arg;
+    pthread_mutex_lock(&lock);
+    for (;;) {
+        while (generation == seen && !stopping) pthread_cond_wait(&wake, &lock);
+        if (stopping) break;
+        seen = generation;
+        pthread_mutex_unlock(&lock);
+        take_items();
+        atomic_fetch_sub(&busy, 1);
+        pthread_mutex_lock(&lock);
+    }
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+// Logical cores, counting the calling thread's (POOL_CORES overrides it,
+// so tests run the threaded path on any machine)
+static int core_count(void) {
+#if defined(POOL_CORES)
+    return POOL_CORES;
+#elif defined(__EMSCRIPTEN__)
+    return emscripten_num_logical_cores();
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
+
+void pool_init(void) {
+    if (worker_count > 0) return;
+    int want = core_count() - 1;
+    if (want > MAX_WORKERS) want = MAX_WORKERS;
+    pthread_mutex_lock(&lock);
+    stopping = false;
+    void *started = (void *)(uintptr_t)generation;
+    pthread_mutex_unlock(&lock);
+    while (worker_count < want) {
+        if (pthread_create(&workers[worker_count], NULL, worker_main, started) != 0) {
+            fprintf(stderr, "pool: started %d of %d threads\n", worker_count, want);
+            break;
+        }
+        worker_count++;
+    }
+}
+
+void pool_shutdown(void) {
+    pthread_mutex_lock(&lock);
+    stopping = true;
+    pthread_cond_broadcast(&wake);
+    pthread_mutex_unlock(&lock);
+    for (int i = 0; i < worker_count; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    worker_count = 0;
+}
+
+void pool_run(int count, void (*fn)(void *ctx, int index), void *ctx) {
+    if (worker_count == 0 || count < 2) {
+        for (int i = 0; i < count; i++) fn(ctx, i);
+        return;
+    }
+
+    pthread_mutex_lock(&lock);
+    job_fn = fn;
+    job_ctx = ctx;
+    job_count = count;
+    atomic_store(&next_item, 0);
+    atomic_store(&busy, worker_count);
+    generation++;
+    pthread_cond_broadcast(&wake);
+    pthread_mutex_unlock(&lock);
+
+    take_items();
+    while (atomic_load(&busy) > 0) sched_yield();
+}
+
+#else
+
+void pool_init(void) {
+}
+
+void pool_shutdown(void) {
+}
+
+void pool_run(int count, void (*fn)(void *ctx, int index), void *ctx) {
+    for (int i = 0; i < count; i++) fn(ctx, i);
+}
+
+#endif // RENDER_THREADS > 1
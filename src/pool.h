@@ -0,0 +1,29 @@
+/**
+ * pool.h - Worker threads for the software renderer (RENDER_THREADS)
+ *
+ * Parallel passes are split into numbered work items (a tile row of a
+ * chunk bake, a band of the screen) and handed to pool_run(). The pool's
+ * threads and the calling thread take items one at a time from a shared
+ * counter, so a thread that finishes early keeps taking items until none
+ * are left, and a few expensive items do not hold the others back.
+ *
+ * Built with RENDER_THREADS > 1 (make RENDERER=soft THREADS=N) the pool
+ * uses pthreads, and Emscripten pthreads on the web. Otherwise, or with a
+ * single core, pool_run() is a plain loop on the calling thread.
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+// Start up to RENDER_THREADS - 1 workers, fewer on machines with fewer
+// cores; without them pool_run() still works, on the calling thread
+void pool_init(void);
+void pool_shutdown(void);
+
+// Call fn(ctx, i) once for every i in [0, count) and return when all calls
+// are done. Calls may run on any thread, in any order, at the same time, so
+// they must write disjoint memory. The caller spins rather than sleeps
+// while the last items finish, which the browser main thread requires.
+void pool_run(int count, void (*fn)(void *ctx, int index), void *ctx);
+
+#endif // POOL_H
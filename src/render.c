@@ -1,1311 +1,1170 @@
 /**
- * render.c - Drawing primitives and rendering
- * 
- * Pixel art rendering for Game Boy style 8x8 tiles.
- * Each furniture piece has hand-crafted pixel patterns.
+ * render.c - Room rendering
+ *
+ * Tiles are drawn from the pre-baked atlas (atlas.c); the pixel art itself
+ * lives with the tile registry in tiles.c.
+ *
+ * A frame is composited from layers, back to front: floors and walls,
+ * furniture, actors (the player), and the HUD. The room layers are cached
+ * and redrawn only where their own tiles changed, so a walking player
+ * costs its own sprite rather than a pass over the room. Furniture in
+ * front of an actor is redrawn over it by the depth pass below.
+ *
+ * Rooms can be larger than the screen. The camera follows the player and
+ * the layers are cached as fixed-size chunks in a bounded LRU pool, baked
+ * when they come into view (or just before, in the direction of travel).
+ * Frame cost and memory follow the screen size and the pool budget, not
+ * the room size.
+ *
+ * With RENDER_GL none of that applies: the room is a texture of tile
+ * indices and gltiles.c draws the screen, player and fade included, in one
+ * draw call, so only the tiles that changed are uploaded each frame.
  */
 
 #include "render.h"
+#include "atlas.h"
+#include "chunks.h"
+#include "cmdbuf.h"
+#include "room.h"
+#include "stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef RENDER_SOFTWARE
+#include "framebuffer.h"
+#include "pool.h"
+#endif
+#ifdef RENDER_GL
+#include "gltiles.h"
+#endif
 
-// Helper to draw a single pixel
-static void draw_pixel(int x, int y, Color c) {
-    SDL_SetRenderDrawColor(g_game.renderer, c.r, c.g, c.b, 255);
-    SDL_RenderDrawPoint(g_game.renderer, x, y);
+// ----------------------------------------------------------------------------
+// Camera
+// ----------------------------------------------------------------------------
+
+static SDL_Point camera = {0, 0};   // World pixel at the screen's top-left
+
+// Player character at its interpolated world position, rounded to whole
+// pixels so the camera and the sprite move together
+static SDL_Point player_world_pos(void) {
+    float x, y;
+    player_draw_pos(&x, &y);
+    return (SDL_Point){(int)(x + 0.5f), (int)(y + 0.5f)};
 }
 
-// Helper to fill a tile with solid color
-static void fill_tile(int px, int py, Color c) {
-    SDL_Rect rect = {px, py, TILE_SIZE, TILE_SIZE};
-    SDL_SetRenderDrawColor(g_game.renderer, c.r, c.g, c.b, 255);
-    SDL_RenderFillRect(g_game.renderer, &rect);
+// Centre on target, clamped to the room; a room narrower than the screen
+// is centred instead
+static int camera_axis(int target, int room_px, int screen_px) {
+    if (room_px <= screen_px) return (room_px - screen_px) / 2;
+    int c = target - screen_px / 2;
+    if (c < 0) return 0;
+    return c > room_px - screen_px ? room_px - screen_px : c;
 }
 
-// Draw floor tile with subtle pattern
-static void draw_floor(int px, int py, int variant) {
-    Color base = variant ? PALETTE[0] : (Color){0x12, 0x40, 0x12};
-    fill_tile(px, py, base);
+// Camera for the player's sprite at a world position
+static SDL_Point camera_at(const Room *room, SDL_Point player) {
+    return (SDL_Point){
+        camera_axis(player.x + PLAYER_SIZE / 2, room->width * TILE_SIZE, WINDOW_WIDTH),
+        camera_axis(player.y + PLAYER_SIZE / 2, room->height * TILE_SIZE, WINDOW_HEIGHT)};
 }
 
-// Draw wall tile - brick pattern
-static void draw_wall(int px, int py, int variant) {
-    fill_tile(px, py, PALETTE[2]);  // Mid green base
-    
-    // Brick lines
-    Color line = PALETTE[0];  // Dark
-    for (int x = 0; x < TILE_SIZE; x++) {
-        draw_pixel(px + x, py + 2, line);
-        draw_pixel(px + x, py + 5, line);
-    }
-    // Vertical mortar - offset per row
-    draw_pixel(px + 3, py + 0, line);
-    draw_pixel(px + 3, py + 1, line);
-    draw_pixel(px + 7, py + 3, line);
-    draw_pixel(px + 7, py + 4, line);
-    draw_pixel(px + 3, py + 6, line);
-    draw_pixel(px + 3, py + 7, line);
-}
-
-// Draw door - 2 tiles wide, 3 tiles tall
-// Variants: 0=top-left, 1=top-right, 2=mid-left, 3=mid-right, 4=bot-left, 5=bot-right
-static void draw_door(int px, int py, int variant) {
-    Color frame = PALETTE[1];   // Light green (wood frame)
-    Color panel = PALETTE[2];   // Mid green (door panel)
-    Color dark = PALETTE[0];    // Dark (shadow/detail)
-    Color highlight = PALETTE[3]; // Highlight
-    
-    fill_tile(px, py, panel);
-    
-    switch (variant) {
-        case 0: // Top-left
-            // Top frame
-            for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px + x, py, frame);
-            for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px + x, py + 1, frame);
-            // Left frame
-            for (int y = 0; y < TILE_SIZE; y++) draw_pixel(px, py + y, frame);
-            for (int y = 0; y < TILE_SIZE; y++) draw_pixel(px + 1, py + y, frame);
-            break;
-        case 1: // Top-right
-            // Top frame
-            for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px + x, py, frame);
-            for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px + x, py + 1, frame);
-            // Right frame
-            for (int y = 0; y < TILE_SIZE; y++) draw_pixel(px + 6, py + y, frame);
-            for (int y = 0; y < TILE_SIZE; y++) draw_pixel(px + 7, py + y, frame);
-            break;
-        case 2: // Mid-left - door handle on right tile, so just frame here
-            for (int y = 0; y < TILE_SIZE; y++) draw_pixel(px, py + y, frame);
-            for (int y = 0; y < TILE_SIZE; y++) draw_pixel(px + 1, py + y, frame);
-            // Panel detail
-            draw_pixel(px + 4, py + 2, dark);
-            draw_pixel(px + 5, py + 2, dark);
-            draw_pixel(px + 4, py + 5, dark);
-            draw_pixel(px + 5, py + 5, dark);
-            break;
-        case 3: // Mid-right - has door handle
-            for (int y = 0; y < TILE_SIZE; y++) draw_pixel(px + 6, py + y, frame);
-            for (int y = 0; y < TILE_SIZE; y++) draw_pixel(px + 7, py + y, frame);
-            // Door handle (knob)
-            draw_pixel(px + 1, py + 3, highlight);
-            draw_pixel(px + 2, py + 3, highlight);
-            draw_pixel(px + 1, py + 4, dark);
-            draw_pixel(px + 2, py + 4, highlight);
-            // Panel detail
-            draw_pixel(px + 4, py + 2, dark);
-            draw_pixel(px + 5, py + 2, dark);
-            draw_pixel(px + 4, py + 5, dark);
-            draw_pixel(px + 5, py + 5, dark);
-            break;
-        case 4: // Bottom-left
-            for (int y = 0; y < TILE_SIZE; y++) draw_pixel(px, py + y, frame);
-            for (int y = 0; y < TILE_SIZE; y++) draw_pixel(px + 1, py + y, frame);
-            // Bottom frame
-            for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px + x, py + 6, frame);
-            for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px + x, py + 7, frame);
-            break;
-        case 5: // Bottom-right
-            for (int y = 0; y < TILE_SIZE; y++) draw_pixel(px + 6, py + y, frame);
-            for (int y = 0; y < TILE_SIZE; y++) draw_pixel(px + 7, py + y, frame);
-            // Bottom frame
-            for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px + x, py + 6, frame);
-            for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px + x, py + 7, frame);
-            break;
-    }
+static void update_camera(const Room *room) {
+    camera = camera_at(room, player_world_pos());
 }
 
-// Draw couch - 8 tiles wide (64px), 4 tiles tall (32px)
-// Top-down 3/4 view: backrest at top, two rows of seat cushions, front edge at bottom
-// Variants: row*8 + col (0-7 = row 0, 8-15 = row 1, 16-23 = row 2, 24-31 = row 3)
-static void draw_couch(int px, int py, int variant) {
-    int col = variant % 8;
-    int row = variant / 8;
+static TileRect room_bounds(const Room *room) {
+    return (TileRect){0, 0, room->width, room->height};
+}
 
-    Color frame = PALETTE[2];
-    Color cushion = PALETTE[1];
-    Color shadow = PALETTE[0];
-    Color highlight = PALETTE[3];
+#ifndef RENDER_GL
 
-    if (row == 0) {
-        fill_tile(px, py, frame);
-        for (int x = 0; x < TILE_SIZE; x++) {
-            draw_pixel(px + x, py, highlight);
-        }
-        if (col == 0) {
-            draw_pixel(px + 7, py + 4, shadow);
-            draw_pixel(px + 7, py + 5, shadow);
-            draw_pixel(px + 7, py + 6, shadow);
-        } else if (col == 7) {
-            draw_pixel(px, py + 4, shadow);
-            draw_pixel(px, py + 5, shadow);
-            draw_pixel(px, py + 6, shadow);
-        } else {
-            for (int x = 0; x < TILE_SIZE; x++) {
-                draw_pixel(px + x, py + 6, cushion);
-                draw_pixel(px + x, py + 7, cushion);
-            }
-            if (col == 2 || col == 4 || col == 6) {
-                draw_pixel(px, py + 3, shadow);
-                draw_pixel(px, py + 4, shadow);
-            }
-        }
-    } else if (row == 1) {
-        if (col == 0) {
-            fill_tile(px, py, frame);
-            draw_pixel(px + 7, py + 0, shadow);
-            draw_pixel(px + 7, py + 1, shadow);
-            draw_pixel(px + 7, py + 6, shadow);
-            draw_pixel(px + 7, py + 7, shadow);
-        } else if (col == 7) {
-            fill_tile(px, py, frame);
-            draw_pixel(px, py + 0, shadow);
-            draw_pixel(px, py + 1, shadow);
-            draw_pixel(px, py + 6, shadow);
-            draw_pixel(px, py + 7, shadow);
-        } else {
-            fill_tile(px, py, cushion);
-            if (col == 2 || col == 4 || col == 6) {
-                for (int y2 = 1; y2 <= 6; y2++) draw_pixel(px, py + y2, shadow);
-            }
-            draw_pixel(px + 3, py + 3, highlight);
-            draw_pixel(px + 4, py + 3, highlight);
-            draw_pixel(px + 3, py + 4, highlight);
-        }
-    } else if (row == 2) {
-        if (col == 0) {
-            fill_tile(px, py, frame);
-            draw_pixel(px + 7, py + 0, shadow);
-            draw_pixel(px + 7, py + 1, shadow);
-            draw_pixel(px + 7, py + 6, shadow);
-            draw_pixel(px + 7, py + 7, shadow);
-        } else if (col == 7) {
-            fill_tile(px, py, frame);
-            draw_pixel(px, py + 0, shadow);
-            draw_pixel(px, py + 1, shadow);
-            draw_pixel(px, py + 6, shadow);
-            draw_pixel(px, py + 7, shadow);
-        } else {
-            fill_tile(px, py, cushion);
-            if (col == 2 || col == 4 || col == 6) {
-                for (int y2 = 1; y2 <= 6; y2++) draw_pixel(px, py + y2, shadow);
+static int floor_div(int a, int b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+// Tiles at least partly on screen with the camera at cam (may reach
+// outside the room)
+static TileRect tiles_seen_from(SDL_Point cam) {
+    int x0 = floor_div(cam.x, TILE_SIZE), y0 = floor_div(cam.y, TILE_SIZE);
+    int x1 = floor_div(cam.x + WINDOW_WIDTH - 1, TILE_SIZE);
+    int y1 = floor_div(cam.y + WINDOW_HEIGHT - 1, TILE_SIZE);
+    return (TileRect){x0, y0, x1 - x0 + 1, y1 - y0 + 1};
+}
+
+static TileRect visible_tiles(void) {
+    return tiles_seen_from(camera);
+}
+
+static TileRect clip_rect(TileRect r, TileRect to) {
+    int x0 = r.x > to.x ? r.x : to.x, y0 = r.y > to.y ? r.y : to.y;
+    int x1 = r.x + r.w < to.x + to.w ? r.x + r.w : to.x + to.w;
+    int y1 = r.y + r.h < to.y + to.h ? r.y + r.h : to.y + to.h;
+    return (TileRect){x0, y0, x1 > x0 ? x1 - x0 : 0, y1 > y0 ? y1 - y0 : 0};
+}
+
+// ----------------------------------------------------------------------------
+// Drawing, in world coordinates offset by the camera
+// ----------------------------------------------------------------------------
+
+static void draw_tile(CmdLayer layer, int tile_x, int tile_y, TileType type, int variant) {
+    g_frame_stats.tiles++;
+    int px = tile_x * TILE_SIZE - camera.x, py = tile_y * TILE_SIZE - camera.y;
+#ifdef RENDER_SOFTWARE
+    (void)layer;
+    fb_blit_tile(px, py, atlas_bitmap(type, variant));
+#else
+    SDL_Rect src = atlas_rect(type, variant);
+    SDL_Rect dst = {px, py, TILE_SIZE, TILE_SIZE};
+    cmd_copy(layer, atlas_texture(), &src, &dst);
+#endif
+}
+
+#endif // !RENDER_GL
+
+// What the screen last showed, for render_pending(); screen_stale is set
+// whenever cached rendering is dropped. The camera follows the player, so
+// the player's position covers scrolling too.
+static Room *screen_room = NULL;
+static SDL_Point screen_player = {-1, -1};
+static bool screen_stale = true;
+
+// Room transition: the last frame of the old room fades out over the new
+// one for TRANSITION_STEPS simulation steps. fading stays set for one
+// frame past the end, which draws the new room alone.
+#define TRANSITION_STEPS 20
+
+static bool fading = false;
+static int fade_start = 0;      // g_game.frame when the transition began
+
+// Share of the old room still showing, 1 down to 0
+static float fade_left(void) {
+    float t = (g_game.frame - fade_start + g_game.alpha) / TRANSITION_STEPS;
+    return t >= 1.0f ? 0.0f : 1.0f - t;
+}
+
+bool render_pending(void) {
+    Room *room = g_game.current_room;
+    SDL_Point player = player_world_pos();
+    return screen_stale || fading || room != screen_room ||
+           (room && room_has_dirty(room)) ||
+           (room && (player.x != screen_player.x || player.y != screen_player.y)) ||
+           stats_overlay_visible();
+}
+
+static void screen_drawn(void) {
+    screen_room = g_game.current_room;
+    screen_player = player_world_pos();
+    screen_stale = false;
+}
+
+#define MAX_DIRTY_RECTS 32
+
+#ifndef RENDER_GL
+
+// ----------------------------------------------------------------------------
+// Chunk cache
+// ----------------------------------------------------------------------------
+
+static bool rect_has(TileRect r, int x, int y) {
+    return x >= r.x && x < r.x + r.w && y >= r.y && y < r.y + r.h;
+}
+
+// Furniture is drawn as one atlas sprite per object, clipped to the area
+// being drawn, while every cell of the object in that area still shows it.
+// Cells of an object partly written over since it was placed go tile by
+// tile instead. A sprite only covers cells of its own object, so sprites
+// and tiles can be drawn in any order.
+static void find_intact(const Room *room, TileRect area, bool intact[ROOM_MAX_OBJECTS]) {
+    for (int i = 0; i < room->object_count; i++) {
+        const RoomObject *obj = &room->objects[i];
+        TileRect cells = clip_rect((TileRect){obj->x, obj->y, obj->w, obj->h}, area);
+        intact[i] = tile_is_sprite((TileType)obj->type) && cells.w > 0 && cells.h > 0;
+        for (int y = cells.y; y < cells.y + cells.h && intact[i]; y++) {
+            for (int x = cells.x; x < cells.x + cells.w && intact[i]; x++) {
+                const Tile *tile = room_tile(room, x, y);
+                intact[i] = tile->type == obj->type && tile->variant == i;
             }
-            draw_pixel(px + 4, py + 2, highlight);
-            draw_pixel(px + 5, py + 2, highlight);
         }
-    } else if (row == 3) {
-        fill_tile(px, py, frame);
-        for (int x = 0; x < TILE_SIZE; x++) {
-            draw_pixel(px + x, py + 6, shadow);
-            draw_pixel(px + x, py + 7, shadow);
-        }
-        if (col == 0 || col == 7) {
-            for (int y2 = 0; y2 < 6; y2++) {
-                draw_pixel(px + 3, py + y2, highlight);
-                draw_pixel(px + 4, py + y2, highlight);
-            }
-        } else {
-            for (int x = 0; x < TILE_SIZE; x++) {
-                draw_pixel(px + x, py, cushion);
-                draw_pixel(px + x, py + 1, cushion);
+    }
+}
+
+// Whether a cell is left to its object's sprite (see find_intact)
+static bool in_sprite(const Room *room, const bool intact[ROOM_MAX_OBJECTS], int x, int y) {
+    const Tile *tile = room_tile(room, x, y);
+    return tile_is_sprite((TileType)tile->type) && intact[tile->variant];
+}
+
+// Part of an object's sprite inside a tile area: source rect within the
+// sprite and destination in world pixels
+static void sprite_part(const RoomObject *obj, TileRect area, SDL_Rect *src, SDL_Rect *dst) {
+    TileRect cells = clip_rect((TileRect){obj->x, obj->y, obj->w, obj->h}, area);
+    *src = (SDL_Rect){(cells.x - obj->x) * TILE_SIZE, (cells.y - obj->y) * TILE_SIZE,
+                      cells.w * TILE_SIZE, cells.h * TILE_SIZE};
+    *dst = (SDL_Rect){cells.x * TILE_SIZE, cells.y * TILE_SIZE, src->w, src->h};
+}
+
+// Both backends keep rendered rooms as CHUNK_TILES-square chunks in a
+// fixed pool of slots, sized once from CHUNK_CACHE_KB; chunks.c decides
+// which slot to reuse, least recently used first. A frame bakes the chunks
+// in view that are not cached, plus a few ahead of the camera, and redraws
+// changed tiles of cached chunks. Room size no longer bounds memory.
+#ifndef CHUNK_CACHE_KB
+#ifdef RENDER_SOFTWARE
+#define CHUNK_CACHE_KB 1024
+#else
+#define CHUNK_CACHE_KB 8192
+#endif
+#endif
+
+#define CHUNK_PREFETCH 2        // Chunks baked ahead of the camera per frame
+#define MAX_REDRAWS 1024        // Changed tiles per frame; more rebake the chunk
+
+typedef struct {
+    int16_t slot, cx, cy;
+    SDL_Rect bounds;            // The part inside the room, in world pixels
+} ChunkRef;
+
+typedef struct { int16_t slot, x, y; } ChunkTile;
+
+static ChunkRef view_chunks[CHUNK_MIN_SLOTS];   // On screen this frame
+static int view_chunk_count = 0;
+static ChunkRef bakes[CHUNK_MAX_SLOTS];         // To draw from scratch
+static int bake_count = 0;
+static ChunkTile redraws[MAX_REDRAWS];          // Changed tiles of cached chunks
+static int redraw_count = 0;
+static bool slot_baking[CHUNK_MAX_SLOTS];
+static int slot_bytes = 0;
+static SDL_Point last_camera;
+
+static bool init_chunks(int bytes_per_slot) {
+    int slots = CHUNK_CACHE_KB * 1024 / bytes_per_slot;
+    if (slots < CHUNK_MIN_SLOTS) {
+        fprintf(stderr, "render: CHUNK_CACHE_KB=%d holds %d chunks, the screen needs %d\n",
+                CHUNK_CACHE_KB, slots, CHUNK_MIN_SLOTS);
+    }
+    if (!chunks_init(slots)) return false;
+    slot_bytes = bytes_per_slot;
+    printf("Chunk cache: %d chunks of %dx%d tiles, %d KB\n", chunks_capacity(),
+           CHUNK_TILES, CHUNK_TILES, chunks_capacity() * slot_bytes / 1024);
+    return true;
+}
+
+// Chunks covering a tile rect inside the room
+static TileRect chunk_span(TileRect tiles) {
+    if (tiles.w <= 0 || tiles.h <= 0) return (TileRect){0, 0, 0, 0};
+    int x0 = tiles.x / CHUNK_TILES, y0 = tiles.y / CHUNK_TILES;
+    return (TileRect){x0, y0, (tiles.x + tiles.w - 1) / CHUNK_TILES - x0 + 1,
+                      (tiles.y + tiles.h - 1) / CHUNK_TILES - y0 + 1};
+}
+
+static ChunkRef chunk_ref(const Room *room, int slot, int cx, int cy) {
+    TileRect t = clip_rect((TileRect){cx * CHUNK_TILES, cy * CHUNK_TILES, CHUNK_TILES, CHUNK_TILES},
+                           room_bounds(room));
+    return (ChunkRef){(int16_t)slot, (int16_t)cx, (int16_t)cy,
+                      {t.x * TILE_SIZE, t.y * TILE_SIZE, t.w * TILE_SIZE, t.h * TILE_SIZE}};
+}
+
+static void queue_bake(const Room *room, int slot, int cx, int cy) {
+    if (slot_baking[slot]) return;
+    slot_baking[slot] = true;
+    bakes[bake_count++] = chunk_ref(room, slot, cx, cy);
+    g_frame_stats.chunk_bakes++;
+}
+
+// Bake a few chunks just past the screen edge the camera is moving toward
+static void prefetch_chunks(const Room *room, TileRect view) {
+    int dx = (camera.x > last_camera.x) - (camera.x < last_camera.x);
+    int dy = (camera.y > last_camera.y) - (camera.y < last_camera.y);
+    if (dx == 0 && dy == 0) return;
+
+    TileRect ahead = clip_rect((TileRect){view.x + dx, view.y + dy, view.w, view.h},
+                               chunk_span(room_bounds(room)));
+    int budget = CHUNK_PREFETCH;
+    for (int cy = ahead.y; cy < ahead.y + ahead.h; cy++) {
+        for (int cx = ahead.x; cx < ahead.x + ahead.w; cx++) {
+            if (rect_has(view, cx, cy)) continue;
+            int slot = chunk_find(room, cx, cy);
+            if (slot >= 0) {
+                chunk_touch(slot);
+            } else if (budget > 0 && (slot = chunk_claim(room, cx, cy, 1)) >= 0) {
+                queue_bake(room, slot, cx, cy);
+                budget--;
             }
         }
     }
 }
 
-// Draw desk - 6 tiles wide (48px), 3 tiles tall (24px)
-// Top-down 3/4 view: surface on top two rows, front edge with legs at bottom
-// Variants: row*6 + col
-static void draw_desk(int px, int py, int variant) {
-    int col = variant % 6;
-    int row = variant / 6;
-
-    Color surface = PALETTE[1];
-    Color edge = PALETTE[2];
-    Color shadow = PALETTE[0];
-    Color highlight = PALETTE[3];
-
-    if (row == 0) {
-        fill_tile(px, py, surface);
-        for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px + x, py, edge);
-        if (col == 0) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) draw_pixel(px, py + y2, edge);
-            draw_pixel(px + 1, py + 1, highlight);
-        }
-        if (col == 5) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) draw_pixel(px + 7, py + y2, edge);
-            draw_pixel(px + 6, py + 1, highlight);
+static void reset_chunk_work(void) {
+    for (int i = 0; i < bake_count; i++) slot_baking[bakes[i].slot] = false;
+    bake_count = redraw_count = view_chunk_count = 0;
+}
+
+// Queue this frame's chunk work and list the chunks on screen
+static void plan_chunks(Room *room) {
+    reset_chunk_work();
+    chunks_begin_frame();
+
+    // Cached chunks in view first, so making room for the rest cannot
+    // evict them (the pool always holds a screenful)
+    TileRect view = chunk_span(clip_rect(visible_tiles(), room_bounds(room)));
+    for (int cy = view.y; cy < view.y + view.h; cy++) {
+        for (int cx = view.x; cx < view.x + view.w; cx++) {
+            int slot = chunk_find(room, cx, cy);
+            if (slot >= 0) chunk_touch(slot);
         }
-        if (col >= 1 && col <= 4) {
-            draw_pixel(px + 2, py + 3, edge);
-            draw_pixel(px + 3, py + 4, edge);
-            draw_pixel(px + 5, py + 5, edge);
-            if (col == 2 || col == 3) {
-                draw_pixel(px + 6, py + 3, edge);
-                draw_pixel(px + 1, py + 6, edge);
+    }
+    for (int cy = view.y; cy < view.y + view.h; cy++) {
+        for (int cx = view.x; cx < view.x + view.w; cx++) {
+            int slot = chunk_find(room, cx, cy);
+            if (slot < 0) {
+                if ((slot = chunk_claim(room, cx, cy, 1)) < 0) continue;
+                queue_bake(room, slot, cx, cy);
             }
+            view_chunks[view_chunk_count++] = chunk_ref(room, slot, cx, cy);
         }
-    } else if (row == 1) {
-        fill_tile(px, py, surface);
-        if (col == 0) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) draw_pixel(px, py + y2, edge);
-        }
-        if (col == 5) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) draw_pixel(px + 7, py + y2, edge);
-        }
-        if (col >= 1 && col <= 4) {
-            for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px + x, py + 5, edge);
-            if (col == 2 || col == 3) {
-                draw_pixel(px + 3, py + 6, shadow);
-                draw_pixel(px + 4, py + 6, shadow);
+    }
+    prefetch_chunks(room, view);
+
+    // Changed tiles of cached chunks; the others are drawn when baked
+    TileRect rects[MAX_DIRTY_RECTS];
+    int count = room_take_dirty(room, rects, MAX_DIRTY_RECTS);
+    for (int i = 0; i < count; i++) {
+        TileRect r = rects[i];
+        for (int y = r.y; y < r.y + r.h; y++) {
+            for (int x = r.x; x < r.x + r.w; x++) {
+                int cx = x / CHUNK_TILES, cy = y / CHUNK_TILES;
+                int slot = chunk_find(room, cx, cy);
+                if (slot < 0 || slot_baking[slot]) continue;
+                if (redraw_count == MAX_REDRAWS) queue_bake(room, slot, cx, cy);
+                else redraws[redraw_count++] = (ChunkTile){(int16_t)slot, (int16_t)x, (int16_t)y};
             }
-            draw_pixel(px + 4, py + 2, edge);
-            draw_pixel(px + 5, py + 3, edge);
-        }
-    } else if (row == 2) {
-        fill_tile(px, py, edge);
-        for (int x = 0; x < TILE_SIZE; x++) {
-            draw_pixel(px + x, py, surface);
-            draw_pixel(px + x, py + 1, surface);
-            draw_pixel(px + x, py + 6, shadow);
-            draw_pixel(px + x, py + 7, shadow);
-        }
-        if (col == 0) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) draw_pixel(px, py + y2, edge);
-            draw_pixel(px + 1, py + 5, shadow);
-            draw_pixel(px + 1, py + 6, shadow);
-            draw_pixel(px + 1, py + 7, shadow);
-            draw_pixel(px, py + 6, shadow);
-            draw_pixel(px, py + 7, shadow);
-        }
-        if (col == 5) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) draw_pixel(px + 7, py + y2, edge);
-            draw_pixel(px + 6, py + 5, shadow);
-            draw_pixel(px + 6, py + 6, shadow);
-            draw_pixel(px + 6, py + 7, shadow);
-            draw_pixel(px + 7, py + 6, shadow);
-            draw_pixel(px + 7, py + 7, shadow);
-        }
-        if (col >= 1 && col <= 4) {
-            draw_pixel(px + 3, py + 3, highlight);
-            draw_pixel(px + 4, py + 3, highlight);
         }
     }
+
+    last_camera = camera;
+    g_frame_stats.chunks = (uint32_t)chunks_resident();
+    g_frame_stats.chunk_kb = (uint32_t)(chunks_capacity() * slot_bytes / 1024);
 }
 
-// Draw laptop - 2 tiles wide, 2 tiles tall
-// Top-down: screen visible (tilted back), keyboard in front
-// Variants: row*2 + col
-static void draw_laptop(int px, int py, int variant) {
-    int col = variant % 2;
-    int row = variant / 2;
-    
-    Color body = PALETTE[2];     // Mid - laptop body
-    Color screen = PALETTE[0];   // Dark - screen (off/dark)
-    Color keys = PALETTE[0];     // Dark - keyboard
-    Color highlight = PALETTE[3];
-    Color frame = PALETTE[1];
-    
-    if (row == 0) {  // Screen (tilted back, viewed from above)
-        fill_tile(px, py, body);
-        // Screen bezel
-        for (int x = 1; x < 7; x++) {
-            for (int y = 1; y < 7; y++) {
-                draw_pixel(px + x, py + y, screen);
-            }
-        }
-        // Screen glare
-        draw_pixel(px + 2, py + 2, highlight);
-        draw_pixel(px + 3, py + 2, highlight);
-        // Screen content hint (code lines)
-        draw_pixel(px + 2, py + 4, frame);
-        draw_pixel(px + 3, py + 4, frame);
-        draw_pixel(px + 4, py + 4, frame);
-        draw_pixel(px + 2, py + 5, frame);
-        draw_pixel(px + 3, py + 5, frame);
-    } else {  // Keyboard/base
-        fill_tile(px, py, body);
-        // Keyboard area
-        for (int x = 1; x < 7; x++) {
-            for (int y = 1; y < 5; y++) {
-                draw_pixel(px + x, py + y, keys);
+// Neighbour prefetch may only take slots unused for this many frames, so
+// it cannot push out the room on screen
+#define NEIGHBOR_MIN_AGE 60
+
+// Queue up to CHUNK_PREFETCH missing chunks of the view a player at
+// (px, py) would see in a room; true if any are still missing after that
+static bool plan_prefetch(const Room *room, int px, int py) {
+    reset_chunk_work();
+    TileRect tiles = tiles_seen_from(camera_at(room, (SDL_Point){px, py}));
+    TileRect view = chunk_span(clip_rect(tiles, room_bounds(room)));
+    int budget = CHUNK_PREFETCH;
+    bool missing = false;
+    for (int cy = view.y; cy < view.y + view.h; cy++) {
+        for (int cx = view.x; cx < view.x + view.w; cx++) {
+            int slot = chunk_find(room, cx, cy);
+            if (slot >= 0) {
+                chunk_touch(slot);
+            } else if (budget == 0) {
+                missing = true;
+            } else if ((slot = chunk_claim(room, cx, cy, NEIGHBOR_MIN_AGE)) >= 0) {
+                queue_bake(room, slot, cx, cy);
+                budget--;
             }
         }
-        // Key rows
-        for (int x = 1; x < 7; x++) {
-            draw_pixel(px + x, py + 1, frame);
-            draw_pixel(px + x, py + 3, frame);
-        }
-        // Trackpad
-        draw_pixel(px + 3, py + 5, frame);
-        draw_pixel(px + 4, py + 5, frame);
-        draw_pixel(px + 3, py + 6, frame);
-        draw_pixel(px + 4, py + 6, frame);
     }
+    return missing;
 }
 
-// Draw interior wall - clean horizontal line, lighter than brick
-static void draw_interior_wall(int px, int py, int variant) {
-    (void)variant;
-    Color base = PALETTE[2];
-    Color line_color = PALETTE[1];
-    Color highlight = PALETTE[3];
-
-    fill_tile(px, py, base);
-    for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px + x, py, highlight);
-    for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px + x, py + 4, line_color);
-    for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px + x, py + 7, line_color);
-}
-
-// Draw rug - edge-flag encoding: bit0=top, bit1=bottom, bit2=left, bit3=right
-static void draw_rug(int px, int py, int variant) {
-    Color base = PALETTE[1];
-    Color border = PALETTE[2];
-    Color pattern = PALETTE[0];
-    Color accent = PALETTE[3];
-
-    int top    = variant & 1;
-    int bottom = (variant >> 1) & 1;
-    int left   = (variant >> 2) & 1;
-    int right  = (variant >> 3) & 1;
-
-    fill_tile(px, py, base);
-
-    if (!top && !bottom && !left && !right) {
-        draw_pixel(px + 3, py + 1, pattern);
-        draw_pixel(px + 4, py + 1, pattern);
-        draw_pixel(px + 2, py + 2, pattern);
-        draw_pixel(px + 5, py + 2, pattern);
-        draw_pixel(px + 2, py + 5, pattern);
-        draw_pixel(px + 5, py + 5, pattern);
-        draw_pixel(px + 3, py + 6, pattern);
-        draw_pixel(px + 4, py + 6, pattern);
-        draw_pixel(px + 3, py + 3, accent);
-        draw_pixel(px + 4, py + 4, accent);
-    } else {
-        draw_pixel(px + 3, py + 3, pattern);
-        draw_pixel(px + 4, py + 4, pattern);
-        draw_pixel(px + 3, py + 4, accent);
-        draw_pixel(px + 4, py + 3, accent);
+// Whether the room fills the screen (otherwise the camera shows its edge)
+static bool room_covers_screen(const Room *room) {
+    return room->width * TILE_SIZE >= WINDOW_WIDTH && room->height * TILE_SIZE >= WINDOW_HEIGHT;
+}
+
+// ----------------------------------------------------------------------------
+// Depth pass
+// ----------------------------------------------------------------------------
+
+// Actors are drawn over the cached room layers, so furniture standing in
+// front of an actor (a lower baseline) is drawn again over it: only the
+// furniture cells the actor overlaps, not whole rows. Those cells and the
+// actors are ordered by baseline with a radix sort, O(actors) per frame.
+#define MAX_ACTORS 16
+#define MAX_DEPTH_ITEMS (MAX_ACTORS * 10)  // An actor and the 3×3 cells it touches
+
+typedef struct {
+    int16_t x, y;       // Actor: top-left world pixel; furniture: tile
+    int16_t actor;      // Index into actors[], or -1 for a furniture cell
+    uint16_t key;       // Baseline * 2, +1 for actors (in front on ties)
+} DepthItem;
+
+_Static_assert((ROOM_MAX_HEIGHT * TILE_SIZE + 1) * 2 <= UINT16_MAX, "depth keys fit 16 bits");
+
+static SDL_Point actors[MAX_ACTORS];
+static int actor_count = 0;
+static DepthItem depth_items[MAX_DEPTH_ITEMS];
+static DepthItem depth_scratch[MAX_DEPTH_ITEMS];
+
+// Stable LSD radix sort on the key, a byte per pass, so the cost is the
+// items plus two 256-entry counts however tall the room is
+static void sort_depth(int count) {
+    DepthItem *from = depth_items, *to = depth_scratch;
+    for (int shift = 0; shift < 16; shift += 8) {
+        uint16_t offsets[257] = {0};
+        for (int i = 0; i < count; i++) offsets[(from[i].key >> shift & 0xFF) + 1]++;
+        for (int d = 0; d < 256; d++) offsets[d + 1] += offsets[d];
+        for (int i = 0; i < count; i++) to[offsets[from[i].key >> shift & 0xFF]++] = from[i];
+        DepthItem *t = from;
+        from = to;
+        to = t;
     }
+}
 
-    if (top) {
-        for (int x = 0; x < TILE_SIZE; x++) {
-            draw_pixel(px + x, py, border);
-            draw_pixel(px + x, py + 1, pattern);
-        }
+// Top-left of every actor sprite on screen this frame (PLAYER_SIZE
+// square), in world pixels
+static void collect_actors(SDL_Point p) {
+    actor_count = 0;
+    if (p.x + PLAYER_SIZE > camera.x && p.x < camera.x + WINDOW_WIDTH &&
+        p.y + PLAYER_SIZE > camera.y && p.y < camera.y + WINDOW_HEIGHT) {
+        actors[actor_count++] = p;
     }
-    if (bottom) {
-        for (int x = 0; x < TILE_SIZE; x++) {
-            draw_pixel(px + x, py + 7, border);
-            draw_pixel(px + x, py + 6, pattern);
+}
+
+static void draw_actor(int index);
+
+// Actors, and the furniture cells in front of them, back to front
+static void render_actors(const Room *room) {
+    int count = 0;
+    for (int a = 0; a < actor_count; a++) {
+        SDL_Point p = actors[a];
+        int baseline = p.y + PLAYER_SIZE;
+        int x0 = p.x / TILE_SIZE, x1 = (p.x + PLAYER_SIZE - 1) / TILE_SIZE;
+        int y0 = p.y / TILE_SIZE, y1 = (p.y + PLAYER_SIZE - 1) / TILE_SIZE;
+        for (int y = y0 < 0 ? 0 : y0; y <= y1 && y < room->height; y++) {
+            for (int x = x0 < 0 ? 0 : x0; x <= x1 && x < room->width; x++) {
+                const Tile *tile = room_tile(room, x, y);
+                if (!tile_is_sprite((TileType)tile->type)) continue;
+                const RoomObject *obj = &room->objects[tile->variant];
+                int front = (obj->y + obj->h) * TILE_SIZE;
+                if (front <= baseline) continue;
+                depth_items[count++] = (DepthItem){(int16_t)x, (int16_t)y, -1,
+                                                   (uint16_t)(front * 2)};
+            }
         }
+        if (baseline < 0) baseline = 0;
+        if (baseline > ROOM_MAX_HEIGHT * TILE_SIZE) baseline = ROOM_MAX_HEIGHT * TILE_SIZE;
+        depth_items[count++] = (DepthItem){(int16_t)p.x, (int16_t)p.y, (int16_t)a,
+                                           (uint16_t)(baseline * 2 + 1)};
     }
-    if (left) {
-        for (int y2 = 0; y2 < TILE_SIZE; y2++) {
-            draw_pixel(px, py + y2, border);
-            draw_pixel(px + 1, py + y2, pattern);
+
+    // An even number of passes leaves the result in depth_items
+    sort_depth(count);
+    for (int i = 0; i < count; i++) {
+        const DepthItem *item = &depth_items[i];
+        if (item->actor >= 0) {
+            draw_actor(item->actor);
+        } else {
+            draw_tile(CMD_LAYER_ACTORS, item->x, item->y,
+                      (TileType)room_tile(room, item->x, item->y)->type,
+                      room_tile_variant(room, item->x, item->y));
         }
     }
-    if (right) {
-        for (int y2 = 0; y2 < TILE_SIZE; y2++) {
-            draw_pixel(px + 7, py + y2, border);
-            draw_pixel(px + 6, py + y2, pattern);
-        }
+}
+
+#endif // !RENDER_GL
+
+#if defined(RENDER_GL)
+
+// The room is a texture of tile indices on the GPU and the screen is one
+// draw call (gltiles.c), so that texture is the only cache: a room is
+// uploaded whole on entry, then only its changed tiles. The depth pass
+// and the cross-fade happen in the same shader. The HUD goes through the
+// command buffer, which needs an SDL_Renderer this backend does not have,
+// so it is not drawn; the stats buffer still fills for shell.html.
+static SDL_GLContext gl_context = NULL;
+static const Room *gl_room = NULL;      // Room in the texture on screen
+static uint32_t gl_serial = 0;
+
+// Uploading a room is one texture update on entry, so there is nothing
+// to bake ahead
+bool render_prefetch(Room *room, int px, int py) {
+    (void)room;
+    (void)px;
+    (void)py;
+    return false;
+}
+
+// The last frame's room texture, camera and player are kept and mixed in
+// by the shader; the new room goes to the other texture
+void render_begin_transition(void) {
+    fading = gl_room && screen_room && !screen_stale;
+    fade_start = g_game.frame;
+    if (fading) gl_tiles_begin_fade();
+    gl_room = NULL;
+}
+
+bool render_init(void) {
+    screen_stale = true;
+    gl_room = NULL;
+    if (!gl_context) {
+        // Attributes were set before the window was created (game.c)
+        gl_context = SDL_GL_CreateContext(g_game.window);
+        if (!gl_context) {
+            fprintf(stderr, "render: SDL_GL_CreateContext failed: %s\n", SDL_GetError());
+            return false;
+        }
+        SDL_GL_SetSwapInterval(1);
     }
+    return gl_tiles_init();
+}
 
-    if (top && left)     { draw_pixel(px, py, accent); }
-    if (top && right)    { draw_pixel(px + 7, py, accent); }
-    if (bottom && left)  { draw_pixel(px, py + 7, accent); }
-    if (bottom && right) { draw_pixel(px + 7, py + 7, accent); }
-}
-
-// Draw plant - 2 tiles wide, 3 tiles tall, variant = row*2 + col
-static void draw_plant(int px, int py, int variant) {
-    int col = variant % 2;
-    int row = variant / 2;
-
-    Color leaf_dark = PALETTE[1];
-    Color leaf_light = PALETTE[3];
-    Color leaf_mid = PALETTE[2];
-    Color pot = PALETTE[1];
-    Color pot_rim = PALETTE[0];
-    Color bg = PALETTE[0];
-
-    if (row == 0) {
-        fill_tile(px, py, bg);
-        if (col == 0) {
-            draw_pixel(px+4, py+0, leaf_mid); draw_pixel(px+5, py+0, leaf_light);
-            draw_pixel(px+6, py+1, leaf_mid);
-            draw_pixel(px+2, py+2, leaf_mid); draw_pixel(px+3, py+2, leaf_light);
-            draw_pixel(px+4, py+2, leaf_mid); draw_pixel(px+5, py+2, leaf_light);
-            draw_pixel(px+6, py+2, leaf_dark); draw_pixel(px+7, py+2, leaf_mid);
-            draw_pixel(px+1, py+3, leaf_dark); draw_pixel(px+2, py+3, leaf_light);
-            draw_pixel(px+3, py+3, leaf_mid); draw_pixel(px+4, py+3, leaf_light);
-            draw_pixel(px+5, py+3, leaf_mid); draw_pixel(px+6, py+3, leaf_light);
-            draw_pixel(px+7, py+3, leaf_mid);
-            draw_pixel(px+1, py+4, leaf_mid); draw_pixel(px+2, py+4, leaf_light);
-            draw_pixel(px+3, py+4, leaf_dark); draw_pixel(px+4, py+4, leaf_light);
-            draw_pixel(px+5, py+4, leaf_mid); draw_pixel(px+6, py+4, leaf_light);
-            draw_pixel(px+7, py+4, leaf_dark);
-            draw_pixel(px+2, py+5, leaf_mid); draw_pixel(px+3, py+5, leaf_light);
-            draw_pixel(px+4, py+5, leaf_mid); draw_pixel(px+5, py+5, leaf_light);
-            draw_pixel(px+6, py+5, leaf_mid); draw_pixel(px+7, py+5, leaf_light);
-            draw_pixel(px+3, py+6, leaf_dark); draw_pixel(px+4, py+6, leaf_mid);
-            draw_pixel(px+5, py+6, leaf_light); draw_pixel(px+6, py+6, leaf_mid);
-            draw_pixel(px+7, py+6, leaf_dark);
-            draw_pixel(px+4, py+7, leaf_mid); draw_pixel(px+5, py+7, leaf_dark);
-            draw_pixel(px+6, py+7, leaf_mid); draw_pixel(px+7, py+7, leaf_mid);
-        } else {
-            draw_pixel(px+1, py+0, leaf_mid); draw_pixel(px+2, py+0, leaf_light);
-            draw_pixel(px+3, py+1, leaf_mid); draw_pixel(px+4, py+1, leaf_dark);
-            draw_pixel(px+0, py+2, leaf_mid); draw_pixel(px+1, py+2, leaf_light);
-            draw_pixel(px+2, py+2, leaf_mid); draw_pixel(px+3, py+2, leaf_light);
-            draw_pixel(px+4, py+2, leaf_dark); draw_pixel(px+5, py+2, leaf_mid);
-            draw_pixel(px+0, py+3, leaf_mid); draw_pixel(px+1, py+3, leaf_mid);
-            draw_pixel(px+2, py+3, leaf_light); draw_pixel(px+3, py+3, leaf_mid);
-            draw_pixel(px+4, py+3, leaf_light); draw_pixel(px+5, py+3, leaf_dark);
-            draw_pixel(px+6, py+3, leaf_mid);
-            draw_pixel(px+0, py+4, leaf_dark); draw_pixel(px+1, py+4, leaf_light);
-            draw_pixel(px+2, py+4, leaf_mid); draw_pixel(px+3, py+4, leaf_light);
-            draw_pixel(px+4, py+4, leaf_dark); draw_pixel(px+5, py+4, leaf_mid);
-            draw_pixel(px+0, py+5, leaf_light); draw_pixel(px+1, py+5, leaf_mid);
-            draw_pixel(px+2, py+5, leaf_light); draw_pixel(px+3, py+5, leaf_dark);
-            draw_pixel(px+4, py+5, leaf_mid);
-            draw_pixel(px+0, py+6, leaf_dark); draw_pixel(px+1, py+6, leaf_mid);
-            draw_pixel(px+2, py+6, leaf_light); draw_pixel(px+3, py+6, leaf_mid);
-            draw_pixel(px+0, py+7, leaf_mid); draw_pixel(px+1, py+7, leaf_mid);
-            draw_pixel(px+2, py+7, leaf_dark);
-        }
-    } else if (row == 1) {
-        fill_tile(px, py, bg);
-        if (col == 0) {
-            draw_pixel(px+3, py+0, leaf_mid); draw_pixel(px+4, py+0, leaf_light);
-            draw_pixel(px+5, py+0, leaf_mid); draw_pixel(px+6, py+0, leaf_dark);
-            draw_pixel(px+7, py+0, leaf_mid);
-            draw_pixel(px+4, py+1, leaf_mid); draw_pixel(px+5, py+1, leaf_dark);
-            draw_pixel(px+6, py+1, leaf_mid); draw_pixel(px+7, py+1, leaf_light);
-            draw_pixel(px+1, py+1, leaf_mid);
-            draw_pixel(px+0, py+2, leaf_light); draw_pixel(px+1, py+2, leaf_dark);
-            draw_pixel(px+5, py+2, leaf_mid); draw_pixel(px+6, py+2, leaf_dark);
-            draw_pixel(px+7, py+2, leaf_mid);
-            draw_pixel(px+6, py+3, leaf_mid); draw_pixel(px+7, py+3, leaf_dark);
-            draw_pixel(px+6, py+4, leaf_dark); draw_pixel(px+7, py+4, leaf_dark);
-            draw_pixel(px+6, py+5, bg); draw_pixel(px+7, py+5, leaf_dark);
-            draw_pixel(px+6, py+6, bg); draw_pixel(px+7, py+6, bg);
-            draw_pixel(px+6, py+7, bg); draw_pixel(px+7, py+7, bg);
-        } else {
-            draw_pixel(px+0, py+0, leaf_mid); draw_pixel(px+1, py+0, leaf_dark);
-            draw_pixel(px+2, py+0, leaf_light); draw_pixel(px+3, py+0, leaf_mid);
-            draw_pixel(px+0, py+1, leaf_light); draw_pixel(px+1, py+1, leaf_mid);
-            draw_pixel(px+2, py+1, leaf_dark); draw_pixel(px+3, py+1, leaf_light);
-            draw_pixel(px+5, py+1, leaf_mid);
-            draw_pixel(px+6, py+2, leaf_light); draw_pixel(px+7, py+2, leaf_mid);
-            draw_pixel(px+0, py+2, leaf_mid); draw_pixel(px+1, py+2, leaf_dark);
-            draw_pixel(px+0, py+3, leaf_dark); draw_pixel(px+1, py+3, leaf_mid);
-            draw_pixel(px+0, py+4, leaf_dark); draw_pixel(px+1, py+4, leaf_dark);
-            draw_pixel(px+0, py+5, leaf_dark); draw_pixel(px+1, py+5, bg);
-            draw_pixel(px+0, py+6, bg); draw_pixel(px+1, py+6, bg);
-            draw_pixel(px+0, py+7, bg); draw_pixel(px+1, py+7, bg);
-        }
-    } else {
-        fill_tile(px, py, bg);
-        if (col == 0) {
-            draw_pixel(px+4, py+0, pot_rim); draw_pixel(px+5, py+0, pot_rim);
-            draw_pixel(px+6, py+0, pot_rim); draw_pixel(px+7, py+0, pot_rim);
-            draw_pixel(px+3, py+1, pot_rim); draw_pixel(px+4, py+1, pot);
-            draw_pixel(px+5, py+1, pot); draw_pixel(px+6, py+1, pot);
-            draw_pixel(px+7, py+1, pot);
-            for (int y2 = 2; y2 < 7; y2++) {
-                int indent = (y2 - 2) / 3;
-                for (int x = 4 + indent; x < TILE_SIZE; x++)
-                    draw_pixel(px + x, py + y2, pot);
-                draw_pixel(px + 4 + indent, py + y2, pot_rim);
-            }
-            draw_pixel(px+6, py+3, leaf_mid); draw_pixel(px+6, py+4, leaf_mid);
-            draw_pixel(px+5, py+7, pot_rim); draw_pixel(px+6, py+7, pot);
-            draw_pixel(px+7, py+7, pot_rim);
+void render_invalidate(void) {
+    gl_room = NULL;
+    screen_stale = true;
+}
+
+void render_shutdown(void) {
+    gl_tiles_shutdown();
+    if (gl_context) SDL_GL_DeleteContext(gl_context);
+    gl_context = NULL;
+    gl_room = NULL;
+    fading = false;
+}
+
+void render_frame(void) {
+    cmd_begin(g_game.renderer);
+    Room *room = g_game.current_room;
+    if (room) {
+        update_camera(room);
+        if (room != gl_room || room->serial != gl_serial) {
+            gl_tiles_upload(room, room_bounds(room));
+            room_clear_dirty(room);
+            gl_room = room;
+            gl_serial = room->serial;
         } else {
-            draw_pixel(px+0, py+0, pot_rim); draw_pixel(px+1, py+0, pot_rim);
-            draw_pixel(px+2, py+0, pot_rim); draw_pixel(px+3, py+0, pot_rim);
-            draw_pixel(px+0, py+1, pot); draw_pixel(px+1, py+1, pot);
-            draw_pixel(px+2, py+1, pot); draw_pixel(px+3, py+1, pot);
-            draw_pixel(px+4, py+1, pot_rim);
-            for (int y2 = 2; y2 < 7; y2++) {
-                int indent = (y2 - 2) / 3;
-                for (int x = 0; x < 4 - indent; x++)
-                    draw_pixel(px + x, py + y2, pot);
-                draw_pixel(px + 3 - indent, py + y2, pot_rim);
-            }
-            draw_pixel(px+1, py+3, leaf_mid); draw_pixel(px+1, py+4, leaf_mid);
-            draw_pixel(px+0, py+7, pot_rim); draw_pixel(px+1, py+7, pot);
-            draw_pixel(px+2, py+7, pot_rim);
+            TileRect rects[MAX_DIRTY_RECTS];
+            int count = room_take_dirty(room, rects, MAX_DIRTY_RECTS);
+            for (int i = 0; i < count; i++) gl_tiles_upload(room, rects[i]);
         }
+
+        float left = fading ? fade_left() : 0.0f;
+        fading = left > 0.0f;
+        SDL_Point player = player_world_pos();
+        gl_tiles_draw(room, camera, &player, left);
     }
+
+    if (stats_overlay_visible()) {
+        stats_draw_overlay();
+    }
+    cmd_flush();
+    screen_drawn();
 }
 
-// Draw nightstand - 2 tiles wide, 2 tiles tall, variant = row*2 + col
-static void draw_nightstand(int px, int py, int variant) {
-    int col = variant % 2;
-    int row = variant / 2;
-
-    Color surface = PALETTE[2];
-    Color body = PALETTE[1];
-    Color shadow = PALETTE[0];
-    Color highlight = PALETTE[3];
-
-    if (row == 0) {
-        fill_tile(px, py, surface);
-        for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px + x, py, highlight);
-        if (col == 0) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) draw_pixel(px, py + y2, body);
-            draw_pixel(px+3, py+1, highlight); draw_pixel(px+4, py+1, highlight);
-            draw_pixel(px+5, py+1, highlight); draw_pixel(px+6, py+1, highlight);
-            draw_pixel(px+7, py+1, highlight);
-            draw_pixel(px+4, py+2, highlight); draw_pixel(px+5, py+2, surface);
-            draw_pixel(px+6, py+2, highlight);
-            draw_pixel(px+5, py+3, shadow);
-            draw_pixel(px+4, py+4, shadow); draw_pixel(px+5, py+4, shadow);
-            draw_pixel(px+6, py+4, shadow);
-            draw_pixel(px+4, py+5, shadow); draw_pixel(px+5, py+5, body);
-            draw_pixel(px+6, py+5, shadow);
-        } else {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) draw_pixel(px+7, py+y2, body);
-            draw_pixel(px+1, py+3, shadow); draw_pixel(px+2, py+3, shadow);
-            draw_pixel(px+3, py+3, shadow);
-            draw_pixel(px+1, py+4, body); draw_pixel(px+2, py+4, body);
-            draw_pixel(px+3, py+4, shadow);
-            draw_pixel(px+1, py+5, body); draw_pixel(px+2, py+5, body);
-            draw_pixel(px+3, py+5, shadow);
-        }
-    } else {
-        fill_tile(px, py, body);
-        if (col == 0) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) draw_pixel(px, py+y2, shadow);
-        }
-        if (col == 1) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) draw_pixel(px+7, py+y2, shadow);
-        }
-        for (int x = (col==0?1:0); x < (col==1?7:TILE_SIZE); x++)
-            draw_pixel(px+x, py+3, shadow);
-        if (col == 0) {
-            draw_pixel(px+6, py+1, highlight); draw_pixel(px+7, py+1, highlight);
-            draw_pixel(px+6, py+5, highlight); draw_pixel(px+7, py+5, highlight);
-        } else {
-            draw_pixel(px+0, py+1, highlight); draw_pixel(px+1, py+1, highlight);
-            draw_pixel(px+0, py+5, highlight); draw_pixel(px+1, py+5, highlight);
-        }
-        for (int x = (col==0?1:0); x < (col==1?7:TILE_SIZE); x++)
-            draw_pixel(px+x, py+7, shadow);
-        if (col == 0) draw_pixel(px+1, py+7, surface);
-        if (col == 1) draw_pixel(px+6, py+7, surface);
+#elif defined(RENDER_SOFTWARE)
+
+// Chunks are indexed bitmaps (floors and furniture are both opaque, so one
+// bitmap holds both), in one block allocated up front. The framebuffer
+// persists between frames: it is recomposited from the chunks when the
+// camera moves, and otherwise only where tiles changed or an actor was
+// last drawn. Furniture cells the depth pass redraws over an actor are
+// room pixels already, so copying the actor's rect back undoes them too.
+//
+// Bakes and full-screen passes run on the worker pool (pool.h), split by
+// tile rows so every item writes pixels of its own; actors and the
+// per-tile updates of a still camera are too small to be worth it.
+#define SLOT_BYTES (CHUNK_PX * CHUNK_PX)
+
+static uint8_t *chunk_pixels = NULL;
+static uint8_t *fade_pixels = NULL;     // Last frame of the old room
+static const Room *fb_room = NULL;
+static SDL_Point fb_camera;
+static SDL_Point actor_shown[MAX_ACTORS];
+static int shown_count = 0;
+
+static SDL_Rect intersect(SDL_Rect a, SDL_Rect b) {
+    int x0 = a.x > b.x ? a.x : b.x, y0 = a.y > b.y ? a.y : b.y;
+    int x1 = a.x + a.w < b.x + b.w ? a.x + a.w : b.x + b.w;
+    int y1 = a.y + a.h < b.y + b.h ? a.y + a.h : b.y + b.h;
+    return (SDL_Rect){x0, y0, x1 > x0 ? x1 - x0 : 0, y1 > y0 ? y1 - y0 : 0};
+}
+
+static uint8_t *slot_row(int slot, int y) {
+    return chunk_pixels + ((size_t)slot * CHUNK_PX + y) * CHUNK_PX;
+}
+
+static void draw_chunk_tile(const Room *room, int slot, int x, int y) {
+    const uint8_t *bitmap = atlas_bitmap((TileType)room_tile(room, x, y)->type,
+                                         room_tile_variant(room, x, y));
+    int px = x % CHUNK_TILES * TILE_SIZE, py = y % CHUNK_TILES * TILE_SIZE;
+    for (int row = 0; row < TILE_SIZE; row++) {
+        memcpy(slot_row(slot, py + row) + px, bitmap + row * TILE_SIZE, TILE_SIZE);
     }
 }
 
-// Draw coffee table - 4 tiles wide, 2 tiles tall, variant = row*4 + col
-static void draw_coffee_table(int px, int py, int variant) {
-    int col = variant % 4;
-    int row = variant / 4;
+// Copy the part of an object's sprite inside a tile area of a chunk
+static void draw_chunk_sprite(const Room *room, const ChunkRef *c, int index, TileRect area) {
+    const RoomObject *obj = &room->objects[index];
+    const uint8_t *bitmap = atlas_sprite_bitmap((TileType)obj->type);
+    int stride = obj->w * TILE_SIZE;
+    SDL_Rect src, dst;
+    sprite_part(obj, area, &src, &dst);
+    int px = dst.x - c->cx * CHUNK_PX, py = dst.y - c->cy * CHUNK_PX;
+    for (int row = 0; row < src.h; row++) {
+        memcpy(slot_row(c->slot, py + row) + px, bitmap + (src.y + row) * stride + src.x,
+               (size_t)src.w);
+    }
+}
 
-    Color surface = PALETTE[3];
-    Color wood = PALETTE[2];
-    Color shadow = PALETTE[0];
-    Color leg = PALETTE[1];
+// Sprites and tiles drawn per pool item, summed into the stats afterwards
+static uint16_t row_draws[CHUNK_MAX_SLOTS * CHUNK_TILES];
 
-    if (row == 0) {
-        fill_tile(px, py, surface);
-        for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px+x, py, wood);
-        if (col == 0) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) draw_pixel(px, py+y2, wood);
-        }
-        if (col == 3) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) draw_pixel(px+7, py+y2, wood);
-        }
-        if (col == 1) {
-            draw_pixel(px+2, py+3, wood); draw_pixel(px+3, py+4, wood);
-            draw_pixel(px+6, py+5, wood);
-            draw_pixel(px+5, py+2, leg); draw_pixel(px+6, py+2, leg);
-            draw_pixel(px+5, py+3, leg); draw_pixel(px+6, py+3, leg);
-        }
-        if (col == 2) {
-            draw_pixel(px+1, py+2, wood); draw_pixel(px+4, py+4, wood);
-            draw_pixel(px+5, py+6, wood);
-        }
-    } else {
-        fill_tile(px, py, shadow);
-        for (int x = 0; x < TILE_SIZE; x++) {
-            draw_pixel(px+x, py, surface);
-            draw_pixel(px+x, py+1, wood);
-        }
-        if (col == 0) {
-            draw_pixel(px, py, wood); draw_pixel(px, py+1, wood);
-            for (int y2 = 2; y2 <= 6; y2++) draw_pixel(px+1, py+y2, leg);
-            draw_pixel(px+1, py+7, wood);
+// Pool item: tile row index % CHUNK_TILES of bake index / CHUNK_TILES
+// (empty where the chunk hangs over the room's edge)
+static void bake_row(void *ctx, int index) {
+    const Room *room = ctx;
+    const ChunkRef *c = &bakes[index / CHUNK_TILES];
+    TileRect row = {c->bounds.x / TILE_SIZE, c->bounds.y / TILE_SIZE + index % CHUNK_TILES,
+                    c->bounds.w / TILE_SIZE, 1};
+    row_draws[index] = 0;
+    if (row.y >= (c->bounds.y + c->bounds.h) / TILE_SIZE) return;
+
+    bool intact[ROOM_MAX_OBJECTS];
+    find_intact(room, row, intact);
+    for (int i = 0; i < room->object_count; i++) {
+        if (!intact[i]) continue;
+        draw_chunk_sprite(room, c, i, row);
+        row_draws[index]++;
+    }
+    for (int x = row.x; x < row.x + row.w; x++) {
+        if (in_sprite(room, intact, x, row.y)) continue;
+        draw_chunk_tile(room, c->slot, x, row.y);
+        row_draws[index]++;
+    }
+}
+
+static void draw_chunks(const Room *room) {
+    // Every bake has a slot of its own, so all their rows are independent
+    int rows = bake_count * CHUNK_TILES;
+    pool_run(rows, bake_row, (void *)room);
+    for (int i = 0; i < rows; i++) {
+        g_frame_stats.tiles += row_draws[i];
+    }
+    for (int i = 0; i < redraw_count; i++) {
+        draw_chunk_tile(room, redraws[i].slot, redraws[i].x, redraws[i].y);
+        g_frame_stats.tiles++;
+    }
+}
+
+// Copy a screen rect inside the room from the chunks into the framebuffer
+static void copy_chunks(SDL_Rect r) {
+    for (int i = 0; i < view_chunk_count; i++) {
+        const ChunkRef *c = &view_chunks[i];
+        SDL_Rect on_screen = {c->bounds.x - camera.x, c->bounds.y - camera.y,
+                              c->bounds.w, c->bounds.h};
+        SDL_Rect part = intersect(intersect(on_screen, r),
+                                  (SDL_Rect){0, 0, WINDOW_WIDTH, WINDOW_HEIGHT});
+        int sx = part.x + camera.x - c->cx * CHUNK_PX, sy = part.y + camera.y - c->cy * CHUNK_PX;
+        for (int y = 0; y < part.h; y++) {
+            memcpy(&g_framebuffer[part.y + y][part.x], slot_row(c->slot, sy + y) + sx,
+                   (size_t)part.w);
         }
-        if (col == 3) {
-            draw_pixel(px+7, py, wood); draw_pixel(px+7, py+1, wood);
-            for (int y2 = 2; y2 <= 6; y2++) draw_pixel(px+6, py+y2, leg);
-            draw_pixel(px+6, py+7, wood);
+    }
+}
+
+// Background under the screen's tile cells outside a room smaller than
+// the screen; the chunks cover the rest
+static void fill_outside(const Room *room) {
+    int tx0 = floor_div(camera.x, TILE_SIZE), ty0 = floor_div(camera.y, TILE_SIZE);
+    for (int ty = ty0; ty * TILE_SIZE < camera.y + WINDOW_HEIGHT; ty++) {
+        bool row_outside = ty < 0 || ty >= room->height;
+        for (int tx = tx0; tx * TILE_SIZE < camera.x + WINDOW_WIDTH; tx++) {
+            if (row_outside || tx < 0 || tx >= room->width) {
+                fb_fill_tile(tx * TILE_SIZE - camera.x, ty * TILE_SIZE - camera.y, 0);
+            }
         }
-        for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px+x, py+7, shadow);
     }
 }
 
-// Draw fridge - 2 tiles wide, 3 tiles tall, variant = row*2 + col
-static void draw_fridge(int px, int py, int variant) {
-    int col = variant % 2;
-    int row = variant / 2;
+static void show_chunks(SDL_Rect r) {
+    copy_chunks(r);
+    fb_mark_dirty(r.x, r.y, r.w, r.h);
+}
 
-    Color body = PALETTE[2];
-    Color edge_c = PALETTE[1];
-    Color shadow = PALETTE[0];
-    Color highlight = PALETTE[3];
+static void show_band(void *ctx, int band) {
+    (void)ctx;
+    copy_chunks(fb_band(band));
+}
 
-    if (row == 0) {
-        fill_tile(px, py, body);
-        for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px+x, py, highlight);
-        if (col == 0) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) draw_pixel(px, py+y2, edge_c);
-            draw_pixel(px+3, py+3, edge_c); draw_pixel(px+5, py+3, edge_c);
-            draw_pixel(px+3, py+5, edge_c); draw_pixel(px+5, py+5, edge_c);
-        }
-        if (col == 1) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) draw_pixel(px+7, py+y2, edge_c);
-            draw_pixel(px+6, py+2, highlight); draw_pixel(px+6, py+3, highlight);
-            draw_pixel(px+6, py+4, highlight); draw_pixel(px+6, py+5, highlight);
-            draw_pixel(px+5, py+3, shadow); draw_pixel(px+5, py+4, shadow);
-        }
-        for (int x = (col==0?1:0); x < (col==1?7:TILE_SIZE); x++)
-            draw_pixel(px+x, py+7, shadow);
-    } else if (row == 1) {
-        fill_tile(px, py, body);
-        if (col == 0) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) draw_pixel(px, py+y2, edge_c);
-            draw_pixel(px+3, py+2, edge_c); draw_pixel(px+4, py+2, edge_c);
-            draw_pixel(px+5, py+2, edge_c);
-            draw_pixel(px+3, py+3, highlight); draw_pixel(px+4, py+3, highlight);
-            draw_pixel(px+5, py+3, edge_c);
-        }
-        if (col == 1) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) draw_pixel(px+7, py+y2, edge_c);
-            for (int y2 = 1; y2 <= 6; y2++) draw_pixel(px+6, py+y2, highlight);
-            for (int y2 = 2; y2 <= 5; y2++) draw_pixel(px+5, py+y2, shadow);
-        }
-    } else {
-        fill_tile(px, py, body);
-        if (col == 0) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) draw_pixel(px, py+y2, edge_c);
-        }
-        if (col == 1) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) draw_pixel(px+7, py+y2, edge_c);
-            draw_pixel(px+6, py+0, highlight); draw_pixel(px+6, py+1, highlight);
-            draw_pixel(px+5, py+0, shadow);
-        }
-        for (int x = 0; x < TILE_SIZE; x++) {
-            draw_pixel(px+x, py+6, edge_c);
-            draw_pixel(px+x, py+7, shadow);
-        }
-        if (col == 0) {
-            draw_pixel(px+1, py+7, edge_c); draw_pixel(px+2, py+7, edge_c);
-        }
-        if (col == 1) {
-            draw_pixel(px+5, py+7, edge_c); draw_pixel(px+6, py+7, edge_c);
+static void draw_actor(int index) {
+    SDL_Point p = actors[index];
+    fb_blit_sprite_keyed(p.x - camera.x, p.y - camera.y, PLAYER_SIZE, PLAYER_SIZE,
+                         atlas_player_bitmap());
+    fb_mark_dirty(p.x - camera.x, p.y - camera.y, PLAYER_SIZE, PLAYER_SIZE);
+    actor_shown[shown_count++] = p;
+    g_frame_stats.tiles++;
+}
+
+// Whether the actors on screen differ from this frame's
+static bool actors_moved(void) {
+    if (shown_count != actor_count) return true;
+    for (int a = 0; a < actor_count; a++) {
+        // Drawn in depth order, so compare as sets
+        bool found = false;
+        for (int s = 0; s < shown_count && !found; s++) {
+            found = actor_shown[s].x == actors[a].x && actor_shown[s].y == actors[a].y;
+        }
+        if (!found) return true;
+    }
+    return false;
+}
+
+// Ordered dissolve: a pixel shows the old room while the share left is
+// above its 4×4 Bayer threshold, so the old room breaks up evenly
+static void dissolve_band(void *ctx, int band) {
+    static const uint8_t BAYER[4][4] = {
+        { 0,  8,  2, 10}, {12,  4, 14,  6}, { 3, 11,  1,  9}, {15,  7, 13,  5},
+    };
+    int level = *(const int *)ctx;
+    SDL_Rect r = fb_band(band);
+    for (int y = r.y; y < r.y + r.h; y++) {
+        const uint8_t *from = fade_pixels + (size_t)y * WINDOW_WIDTH;
+        const uint8_t *bayer = BAYER[y & 3];
+        for (int x = 0; x < WINDOW_WIDTH; x++) {
+            if (bayer[x & 3] < level) fb_draw_pixel(x, y, from[x]);
         }
     }
 }
 
-// Draw bookshelf - 12 tiles wide, 2 tiles tall, variant = row*12 + col
-static void draw_bookshelf(int px, int py, int variant) {
-    int col = variant % 12;
-    int row = variant / 12;
+static void dissolve(float left) {
+    int level = (int)(left * 16.0f + 0.5f);
+    pool_run(FB_BANDS, dissolve_band, &level);
+    fb_mark_dirty(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+}
 
-    Color dark = PALETTE[0];
-    Color mid = PALETTE[1];
-    Color light = PALETTE[2];
-    Color bright = PALETTE[3];
+bool render_prefetch(Room *room, int px, int py) {
+    bool missing = plan_prefetch(room, px, py);
+    draw_chunks(room);
+    return missing;
+}
 
-    if (row == 0) {
-        fill_tile(px, py, mid);
-        for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px+x, py, light);
-        if (col == 0) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) {
-                draw_pixel(px, py+y2, dark); draw_pixel(px+1, py+y2, dark);
-            }
-            for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px+x, py, light);
-            draw_pixel(px+3, py+3, dark); draw_pixel(px+4, py+5, dark);
-            for (int y2 = 2; y2 < 7; y2++) {
-                draw_pixel(px+6, py+y2, bright); draw_pixel(px+7, py+y2, light);
-            }
-            return;
-        }
-        if (col == 11) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) {
-                draw_pixel(px+6, py+y2, dark); draw_pixel(px+7, py+y2, dark);
-            }
-            for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px+x, py, light);
-            draw_pixel(px+4, py+3, dark); draw_pixel(px+3, py+5, dark);
-            for (int y2 = 2; y2 < 7; y2++) {
-                draw_pixel(px, py+y2, light); draw_pixel(px+1, py+y2, bright);
-            }
-            return;
-        }
-        for (int y2 = 2; y2 < TILE_SIZE; y2++) {
-            for (int x = 0; x < TILE_SIZE; x++) {
-                int book_id = (col * TILE_SIZE + x) % 7;
-                Color spine;
-                switch (book_id) {
-                    case 0: case 1: spine = dark; break;
-                    case 2: case 3: spine = bright; break;
-                    case 4:         spine = light; break;
-                    default:        spine = mid; break;
-                }
-                draw_pixel(px+x, py+y2, spine);
-            }
-        }
-        draw_pixel(px+2, py+3, dark); draw_pixel(px+2, py+4, dark);
-        draw_pixel(px+5, py+3, dark); draw_pixel(px+5, py+4, dark);
-        if (col % 3 == 1) {
-            draw_pixel(px+3, py+1, bright); draw_pixel(px+4, py+1, bright);
-        }
-    } else {
-        fill_tile(px, py, dark);
-        if (col == 0) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) {
-                draw_pixel(px, py+y2, dark); draw_pixel(px+1, py+y2, dark);
-            }
-            for (int x = 2; x < TILE_SIZE; x++)
-                for (int y2 = 0; y2 < 6; y2++) draw_pixel(px+x, py+y2, mid);
-            for (int x = 0; x < TILE_SIZE; x++) {
-                draw_pixel(px+x, py+6, dark); draw_pixel(px+x, py+7, dark);
-            }
-            return;
-        }
-        if (col == 11) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) {
-                draw_pixel(px+6, py+y2, dark); draw_pixel(px+7, py+y2, dark);
-            }
-            for (int x = 0; x < 6; x++)
-                for (int y2 = 0; y2 < 6; y2++) draw_pixel(px+x, py+y2, mid);
-            for (int x = 0; x < TILE_SIZE; x++) {
-                draw_pixel(px+x, py+6, dark); draw_pixel(px+x, py+7, dark);
-            }
-            return;
-        }
-        for (int x = 0; x < TILE_SIZE; x++) {
-            int book_id = (col * TILE_SIZE + x + 3) % 6;
-            Color spine;
-            switch (book_id) {
-                case 0:         spine = bright; break;
-                case 1: case 2: spine = light; break;
-                case 3:         spine = mid; break;
-                default:        spine = dark; break;
-            }
-            for (int y2 = 0; y2 < 6; y2++) draw_pixel(px+x, py+y2, spine);
-        }
-        for (int x = 0; x < TILE_SIZE; x++) {
-            draw_pixel(px+x, py+6, dark); draw_pixel(px+x, py+7, dark);
-        }
-        if (col % 2 == 0) {
-            draw_pixel(px+1, py+2, bright); draw_pixel(px+1, py+3, bright);
-            draw_pixel(px+6, py+1, dark); draw_pixel(px+6, py+2, dark);
-        } else {
-            draw_pixel(px+3, py+2, dark); draw_pixel(px+4, py+2, dark);
-            draw_pixel(px+3, py+3, dark);
-        }
+void render_begin_transition(void) {
+    // The framebuffer still holds the last frame shown
+    fading = screen_room && !screen_stale;
+    fade_start = g_game.frame;
+    if (fading) memcpy(fade_pixels, g_framebuffer, (size_t)WINDOW_WIDTH * WINDOW_HEIGHT);
+}
+
+bool render_init(void) {
+    render_invalidate();
+    if (!init_chunks(SLOT_BYTES)) return false;
+    chunk_pixels = malloc((size_t)chunks_capacity() * SLOT_BYTES);
+    fade_pixels = malloc((size_t)WINDOW_WIDTH * WINDOW_HEIGHT);
+    if (!chunk_pixels || !fade_pixels) {
+        fprintf(stderr, "render: out of memory for the chunk cache\n");
+        render_shutdown();
+        return false;
     }
+    pool_init();
+    return fb_init();
 }
 
-// Draw counter - 12 tiles wide, 2 tiles tall, variant = row*12 + col
-static void draw_counter(int px, int py, int variant) {
-    int col = variant % 12;
-    int row = variant / 12;
+void render_invalidate(void) {
+    chunks_clear();
+    fb_room = NULL;
+    shown_count = 0;
+    screen_stale = true;
+}
 
-    Color dark = PALETTE[0];
-    Color mid = PALETTE[1];
-    Color light = PALETTE[2];
-    Color bright = PALETTE[3];
+void render_shutdown(void) {
+    pool_shutdown();
+    fb_shutdown();
+    chunks_shutdown();
+    free(chunk_pixels);
+    free(fade_pixels);
+    chunk_pixels = fade_pixels = NULL;
+    fb_room = NULL;
+    shown_count = 0;
+    fading = false;
+}
 
-    if (row == 0) {
-        fill_tile(px, py, light);
-        for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px+x, py, mid);
-        for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px+x, py+7, mid);
-        if (col == 0) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) {
-                draw_pixel(px, py+y2, mid); draw_pixel(px+1, py+y2, mid);
-            }
-            for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px+x, py, mid);
-            for (int x = 2; x < TILE_SIZE; x++)
-                for (int y2 = 1; y2 < 7; y2++) draw_pixel(px+x, py+y2, light);
-            return;
-        }
-        if (col == 11) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) {
-                draw_pixel(px+6, py+y2, mid); draw_pixel(px+7, py+y2, mid);
-            }
-            for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px+x, py, mid);
-            for (int x = 0; x < 6; x++)
-                for (int y2 = 1; y2 < 7; y2++) draw_pixel(px+x, py+y2, light);
-            return;
-        }
-        if (col == 4) {
-            draw_pixel(px+2,py+2,dark); draw_pixel(px+3,py+2,dark);
-            draw_pixel(px+4,py+2,dark);
-            draw_pixel(px+1,py+3,dark); draw_pixel(px+5,py+3,dark);
-            draw_pixel(px+1,py+4,dark); draw_pixel(px+5,py+4,dark);
-            draw_pixel(px+2,py+5,dark); draw_pixel(px+3,py+5,dark);
-            draw_pixel(px+4,py+5,dark);
-            draw_pixel(px+3,py+3,mid); draw_pixel(px+3,py+4,mid);
-        }
-        if (col == 5) {
-            draw_pixel(px+3,py+2,dark); draw_pixel(px+4,py+2,dark);
-            draw_pixel(px+2,py+3,dark); draw_pixel(px+5,py+3,dark);
-            draw_pixel(px+2,py+4,dark); draw_pixel(px+5,py+4,dark);
-            draw_pixel(px+3,py+5,dark); draw_pixel(px+4,py+5,dark);
-            draw_pixel(px+3,py+3,mid); draw_pixel(px+4,py+4,mid);
-        }
-        if (col == 8) {
-            for (int x=1; x<TILE_SIZE; x++)
-                for (int y2=2; y2<6; y2++) draw_pixel(px+x, py+y2, mid);
-            for (int x=1; x<TILE_SIZE; x++) draw_pixel(px+x, py+1, bright);
-            for (int x=1; x<TILE_SIZE; x++) draw_pixel(px+x, py+6, bright);
-            for (int y2=1; y2<7; y2++) draw_pixel(px+1, py+y2, bright);
-            draw_pixel(px+4,py+3,dark); draw_pixel(px+5,py+4,dark);
-        }
-        if (col == 9) {
-            for (int x=0; x<7; x++)
-                for (int y2=2; y2<6; y2++) draw_pixel(px+x, py+y2, mid);
-            for (int x=0; x<7; x++) draw_pixel(px+x, py+1, bright);
-            for (int x=0; x<7; x++) draw_pixel(px+x, py+6, bright);
-            for (int y2=1; y2<7; y2++) draw_pixel(px+6, py+y2, bright);
-            draw_pixel(px+3,py+2,dark); draw_pixel(px+3,py+3,dark);
-            draw_pixel(px+4,py+2,mid);
-        }
-        if (col!=4 && col!=5 && col!=8 && col!=9 && col!=0 && col!=11) {
-            if (col % 3 == 0) {
-                draw_pixel(px+2, py+3, bright);
-                draw_pixel(px+5, py+5, bright);
-            }
-        }
+void render_frame(void) {
+    cmd_begin(g_game.renderer);
+    Room *room = g_game.current_room;
+    if (!room) {
+        fb_clear(0);
+        fb_room = NULL;
+        shown_count = 0;
     } else {
-        fill_tile(px, py, mid);
-        if (col == 0) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) {
-                draw_pixel(px, py+y2, dark); draw_pixel(px+1, py+y2, dark);
+        update_camera(room);
+        plan_chunks(room);
+        draw_chunks(room);
+        collect_actors(player_world_pos());
+
+        // A transition dissolves the whole screen, and the frame after it
+        // must replace every pixel it left
+        float left = fading ? fade_left() : 0.0f;
+        if (fading) fb_room = NULL;
+        fading = left > 0.0f;
+
+        // Tiles under the actors may change, so they are redrawn with them
+        bool scrolled = fb_room != room || camera.x != fb_camera.x || camera.y != fb_camera.y;
+        bool actors_stale = scrolled || redraw_count > 0 || actors_moved();
+        if (scrolled) {
+            if (!room_covers_screen(room)) fill_outside(room);
+            pool_run(FB_BANDS, show_band, NULL);
+            fb_mark_dirty(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+        } else {
+            for (int i = 0; i < redraw_count; i++) {
+                show_chunks((SDL_Rect){redraws[i].x * TILE_SIZE - camera.x,
+                                       redraws[i].y * TILE_SIZE - camera.y, TILE_SIZE, TILE_SIZE});
             }
-            for (int x=2; x<TILE_SIZE; x++)
-                for (int y2=0; y2<TILE_SIZE; y2++) draw_pixel(px+x, py+y2, mid);
-            for (int x=0; x<TILE_SIZE; x++) draw_pixel(px+x, py+7, dark);
-            draw_pixel(px+5, py+3, bright); draw_pixel(px+5, py+4, bright);
-            return;
-        }
-        if (col == 11) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) {
-                draw_pixel(px+6, py+y2, dark); draw_pixel(px+7, py+y2, dark);
+            for (int s = 0; s < shown_count && actors_stale; s++) {
+                show_chunks((SDL_Rect){actor_shown[s].x - camera.x, actor_shown[s].y - camera.y,
+                                       PLAYER_SIZE, PLAYER_SIZE});
             }
-            for (int x=0; x<TILE_SIZE; x++) draw_pixel(px+x, py+7, dark);
-            draw_pixel(px+2, py+3, bright); draw_pixel(px+2, py+4, bright);
-            return;
-        }
-        for (int x=0; x<TILE_SIZE; x++) draw_pixel(px+x, py, light);
-        for (int x=0; x<TILE_SIZE; x++) draw_pixel(px+x, py+7, dark);
-        if (col % 2 == 1) {
-            for (int y2=0; y2<7; y2++) draw_pixel(px+7, py+y2, dark);
         }
-        if (col % 2 == 0) {
-            draw_pixel(px+6, py+3, bright); draw_pixel(px+6, py+4, bright);
-        } else {
-            draw_pixel(px+1, py+3, bright); draw_pixel(px+1, py+4, bright);
+        fb_room = room;
+        fb_camera = camera;
+        if (actors_stale) {
+            shown_count = 0;
+            render_actors(room);
         }
-        draw_pixel(px+2, py+2, dark); draw_pixel(px+5, py+2, dark);
-        draw_pixel(px+2, py+5, dark); draw_pixel(px+5, py+5, dark);
+        if (fading) dissolve(left);
+    }
+
+    // Uploads only the regions marked since the last present
+    fb_present();
+
+    if (stats_overlay_visible()) {
+        stats_draw_overlay();
     }
+    cmd_flush();
+    screen_drawn();
 }
 
-// Draw TV - 6 tiles wide, 2 tiles tall, variant = row*6 + col
-static void draw_tv(int px, int py, int variant) {
-    int col = variant % 6;
-    int row = variant / 6;
+#else
 
-    Color dark = PALETTE[0];
-    Color mid = PALETTE[1];
-    Color light = PALETTE[2];
-    Color bright = PALETTE[3];
+// Chunks live in two texture pages, CHUNK_PAGE_COLS slots wide: the floor
+// page holds every tile that is not a sprite object, the furniture page
+// the sprite cells over a transparent background. Compositing is one copy
+// per visible chunk and page, all from the same texture, so each page
+// goes out as one batch.
+#define CHUNK_PAGE_COLS 8
+#define SLOT_BYTES (2 * CHUNK_PX * CHUNK_PX * 4)
 
-    if (row == 0) {
-        fill_tile(px, py, dark);
-        for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px+x, py, mid);
-        for (int x = 0; x < TILE_SIZE; x++) draw_pixel(px+x, py+7, mid);
+static SDL_Texture *floor_page = NULL;
+static SDL_Texture *furniture_page = NULL;
+static bool slot_furniture[CHUNK_MAX_SLOTS];    // Slot has opaque furniture cells
+static SDL_Texture *fade_texture = NULL;        // Last frame of the old room
 
-        if (col == 0) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) {
-                draw_pixel(px, py+y2, mid); draw_pixel(px+1, py+y2, mid);
-            }
-            draw_pixel(px+3, py+2, mid); draw_pixel(px+4, py+2, mid);
-            draw_pixel(px+3, py+3, mid);
-        } else if (col == 5) {
-            for (int y2 = 0; y2 < TILE_SIZE; y2++) {
-                draw_pixel(px+6, py+y2, mid); draw_pixel(px+7, py+y2, mid);
-            }
-            draw_pixel(px+5, py+7, bright);
-        } else {
-            if (col == 1) {
-                draw_pixel(px+0, py+2, mid); draw_pixel(px+1, py+2, mid);
-                draw_pixel(px+1, py+3, mid); draw_pixel(px+2, py+3, mid);
-            }
-            if (col == 2 || col == 3) {
-                draw_pixel(px+1, py+3, mid); draw_pixel(px+2, py+3, mid);
-                draw_pixel(px+3, py+3, mid); draw_pixel(px+4, py+3, mid);
-                draw_pixel(px+5, py+3, mid);
-                draw_pixel(px+2, py+5, mid); draw_pixel(px+3, py+5, mid);
-                draw_pixel(px+4, py+5, mid);
-            }
-        }
-    } else {
-        fill_tile(px, py, dark);
-        if (col == 2 || col == 3) {
-            for (int x=1; x<7; x++) {
-                draw_pixel(px+x, py, mid); draw_pixel(px+x, py+1, mid);
-            }
-            for (int x=2; x<6; x++) {
-                draw_pixel(px+x, py+2, mid); draw_pixel(px+x, py+3, mid);
-            }
-            for (int x=0; x<TILE_SIZE; x++) {
-                draw_pixel(px+x, py+4, mid); draw_pixel(px+x, py+5, mid);
-            }
-            draw_pixel(px+3, py+1, light); draw_pixel(px+4, py+1, light);
-        } else if (col == 1 || col == 4) {
-            for (int x=0; x<TILE_SIZE; x++) draw_pixel(px+x, py, mid);
-        }
+static void destroy_pages(void) {
+    if (floor_page) SDL_DestroyTexture(floor_page);
+    if (furniture_page) SDL_DestroyTexture(furniture_page);
+    floor_page = furniture_page = NULL;
+    chunks_clear();
+}
+
+static bool create_pages(void) {
+    if (floor_page) return true;
+    if (!SDL_RenderTargetSupported(g_game.renderer)) return false;
+    int w = CHUNK_PAGE_COLS * CHUNK_PX;
+    int h = (chunks_capacity() + CHUNK_PAGE_COLS - 1) / CHUNK_PAGE_COLS * CHUNK_PX;
+    floor_page = SDL_CreateTexture(g_game.renderer, SDL_PIXELFORMAT_ARGB8888,
+                                   SDL_TEXTUREACCESS_TARGET, w, h);
+    furniture_page = SDL_CreateTexture(g_game.renderer, SDL_PIXELFORMAT_ARGB8888,
+                                       SDL_TEXTUREACCESS_TARGET, w, h);
+    if (!floor_page || !furniture_page) {
+        destroy_pages();
+        return false;
     }
+    SDL_SetTextureBlendMode(furniture_page, SDL_BLENDMODE_BLEND);
+    chunks_clear();
+    return true;
 }
 
-// Draw bed - 8 tiles wide, 8 tiles tall, variant = row*8 + col
-static void draw_bed(int px, int py, int variant) {
-    int col = variant % 8;
-    int row = variant / 8;
+static bool begin_layer(SDL_Texture *layer) {
+    if (SDL_SetRenderTarget(g_game.renderer, layer) < 0) return false;
+    g_frame_stats.draw_calls++;
+    return true;
+}
 
-    Color dark = PALETTE[0];
-    Color mid = PALETTE[1];
-    Color light = PALETTE[2];
-    Color bright = PALETTE[3];
+static void end_layer(void) {
+    cmd_flush();
+    SDL_SetRenderTarget(g_game.renderer, NULL);
+    g_frame_stats.draw_calls++;
+}
 
-    switch (row) {
-    case 0: {
-        fill_tile(px, py, mid);
-        for (int x=0; x<TILE_SIZE; x++) {
-            draw_pixel(px+x, py, light); draw_pixel(px+x, py+1, light);
-        }
-        draw_pixel(px+2, py+3, dark); draw_pixel(px+2, py+4, dark); draw_pixel(px+2, py+5, dark);
-        draw_pixel(px+5, py+3, dark); draw_pixel(px+5, py+4, dark); draw_pixel(px+5, py+5, dark);
-        if (col == 0) {
-            for (int y2=0; y2<TILE_SIZE; y2++) { draw_pixel(px, py+y2, dark); draw_pixel(px+1, py+y2, dark); }
-            draw_pixel(px, py, light); draw_pixel(px+1, py, light);
-            draw_pixel(px, py+1, light); draw_pixel(px+1, py+1, light);
-        }
-        if (col == 7) {
-            for (int y2=0; y2<TILE_SIZE; y2++) { draw_pixel(px+6, py+y2, dark); draw_pixel(px+7, py+y2, dark); }
-            draw_pixel(px+6, py, light); draw_pixel(px+7, py, light);
-            draw_pixel(px+6, py+1, light); draw_pixel(px+7, py+1, light);
+// A slot's top-left in the pages
+static SDL_Point slot_origin(int slot) {
+    return (SDL_Point){slot % CHUNK_PAGE_COLS * CHUNK_PX, slot / CHUNK_PAGE_COLS * CHUNK_PX};
+}
+
+static SDL_Rect slot_tile_rect(int slot, int x, int y) {
+    SDL_Point o = slot_origin(slot);
+    return (SDL_Rect){o.x + x % CHUNK_TILES * TILE_SIZE, o.y + y % CHUNK_TILES * TILE_SIZE,
+                      TILE_SIZE, TILE_SIZE};
+}
+
+static void draw_chunk_tile(CmdLayer layer, const Room *room, int slot, int x, int y) {
+    SDL_Rect src = atlas_rect((TileType)room_tile(room, x, y)->type, room_tile_variant(room, x, y));
+    SDL_Rect dst = slot_tile_rect(slot, x, y);
+    cmd_copy(layer, atlas_texture(), &src, &dst);
+    g_frame_stats.tiles++;
+}
+
+static bool is_furniture(const Room *room, int x, int y) {
+    return tile_is_sprite((TileType)room_tile(room, x, y)->type);
+}
+
+// Floor page: every baked or changed tile that is not furniture (sprite
+// cells are left alone, the furniture page is opaque over them)
+static void draw_floor_page(const Room *room) {
+    for (int i = 0; i < bake_count; i++) {
+        SDL_Rect b = bakes[i].bounds;
+        for (int y = b.y / TILE_SIZE; y < (b.y + b.h) / TILE_SIZE; y++) {
+            for (int x = b.x / TILE_SIZE; x < (b.x + b.w) / TILE_SIZE; x++) {
+                if (!is_furniture(room, x, y)) draw_chunk_tile(CMD_LAYER_WORLD, room, bakes[i].slot, x, y);
+            }
         }
-        break;
     }
-    case 1: {
-        fill_tile(px, py, bright);
-        for (int x=0; x<TILE_SIZE; x++) { draw_pixel(px+x, py, light); draw_pixel(px+x, py+7, light); }
-        if (col == 0) {
-            for (int y2=0; y2<TILE_SIZE; y2++) { draw_pixel(px, py+y2, dark); draw_pixel(px+1, py+y2, mid); }
-            return;
-        }
-        if (col == 7) {
-            for (int y2=0; y2<TILE_SIZE; y2++) { draw_pixel(px+7, py+y2, dark); draw_pixel(px+6, py+y2, mid); }
-            return;
-        }
-        if (col == 3) { for (int y2=1; y2<7; y2++) draw_pixel(px+7, py+y2, light); }
-        if (col == 4) { for (int y2=1; y2<7; y2++) draw_pixel(px, py+y2, light); }
-        if (col == 2 || col == 5) {
-            draw_pixel(px+3, py+3, bright); draw_pixel(px+4, py+3, bright);
-            draw_pixel(px+3, py+4, bright); draw_pixel(px+4, py+4, bright);
-        }
-        if (col == 1 || col == 6) {
-            draw_pixel(px+4, py+4, light); draw_pixel(px+5, py+5, light);
-        }
-        break;
+    for (int i = 0; i < redraw_count; i++) {
+        const ChunkTile *t = &redraws[i];
+        if (!is_furniture(room, t->x, t->y)) draw_chunk_tile(CMD_LAYER_WORLD, room, t->slot, t->x, t->y);
     }
-    case 2: case 3: case 4: case 5: {
-        fill_tile(px, py, light);
-        if (col == 0) {
-            for (int y2=0; y2<TILE_SIZE; y2++) { draw_pixel(px, py+y2, dark); draw_pixel(px+1, py+y2, mid); draw_pixel(px+2, py+y2, mid); }
-            return;
-        }
-        if (col == 7) {
-            for (int y2=0; y2<TILE_SIZE; y2++) { draw_pixel(px+7, py+y2, dark); draw_pixel(px+6, py+y2, mid); draw_pixel(px+5, py+y2, mid); }
-            return;
-        }
-        if (row == 2) {
-            for (int x=0; x<TILE_SIZE; x++) { draw_pixel(px+x, py, mid); draw_pixel(px+x, py+1, mid); }
+}
+
+// Furniture page: a baked slot is cleared to transparent, then gets one
+// sprite per object (see find_intact) and any furniture cells left over; a
+// changed cell gets its tile, or is cleared if it stopped being furniture.
+// Clears go on the WORLD layer and sprites on FURNITURE, so cmd_flush()
+// orders them even where they overlap.
+static void draw_furniture_page(const Room *room) {
+    for (int i = 0; i < bake_count; i++) {
+        int slot = bakes[i].slot;
+        SDL_Point o = slot_origin(slot);
+        SDL_Rect r = {o.x, o.y, CHUNK_PX, CHUNK_PX};
+        cmd_fill(CMD_LAYER_WORLD, PALETTE[0], 0, &r);
+        slot_furniture[slot] = false;
+
+        SDL_Rect b = bakes[i].bounds;
+        TileRect area = {b.x / TILE_SIZE, b.y / TILE_SIZE, b.w / TILE_SIZE, b.h / TILE_SIZE};
+        bool intact[ROOM_MAX_OBJECTS];
+        find_intact(room, area, intact);
+        for (int k = 0; k < room->object_count; k++) {
+            if (!intact[k]) continue;
+            SDL_Rect sprite = atlas_sprite_rect((TileType)room->objects[k].type);
+            SDL_Rect src, dst;
+            sprite_part(&room->objects[k], area, &src, &dst);
+            src.x += sprite.x;
+            src.y += sprite.y;
+            dst.x += o.x - bakes[i].cx * CHUNK_PX;
+            dst.y += o.y - bakes[i].cy * CHUNK_PX;
+            cmd_copy(CMD_LAYER_FURNITURE, atlas_texture(), &src, &dst);
+            slot_furniture[slot] = true;
+            g_frame_stats.tiles++;
+        }
+        for (int y = area.y; y < area.y + area.h; y++) {
+            for (int x = area.x; x < area.x + area.w; x++) {
+                if (!is_furniture(room, x, y) || in_sprite(room, intact, x, y)) continue;
+                draw_chunk_tile(CMD_LAYER_FURNITURE, room, slot, x, y);
+                slot_furniture[slot] = true;
+            }
         }
-        if (row == 3 || row == 4) {
-            for (int x=0; x<TILE_SIZE; x++) draw_pixel(px+x, py+4, mid);
+    }
+    for (int i = 0; i < redraw_count; i++) {
+        const ChunkTile *t = &redraws[i];
+        if (is_furniture(room, t->x, t->y)) {
+            draw_chunk_tile(CMD_LAYER_FURNITURE, room, t->slot, t->x, t->y);
+            slot_furniture[t->slot] = true;
+        } else if (slot_furniture[t->slot]) {
+            SDL_Rect r = slot_tile_rect(t->slot, t->x, t->y);
+            cmd_fill(CMD_LAYER_WORLD, PALETTE[0], 0, &r);
         }
-        if ((col + row) % 2 == 0) {
-            draw_pixel(px+3, py+1, bright); draw_pixel(px+4, py+1, bright);
-            draw_pixel(px+2, py+2, mid); draw_pixel(px+5, py+2, mid);
-            draw_pixel(px+2, py+5, mid); draw_pixel(px+5, py+5, mid);
-            draw_pixel(px+3, py+6, bright); draw_pixel(px+4, py+6, bright);
+    }
+}
+
+static bool draw_chunks(const Room *room) {
+    bool floor_changed = bake_count > 0, furniture_changed = bake_count > 0;
+    for (int i = 0; i < redraw_count; i++) {
+        if (is_furniture(room, redraws[i].x, redraws[i].y)) {
+            furniture_changed = true;
         } else {
-            draw_pixel(px+1, py+3, mid); draw_pixel(px+6, py+3, mid);
-            draw_pixel(px+3, py+3, bright); draw_pixel(px+4, py+3, bright);
+            floor_changed = true;
+            if (slot_furniture[redraws[i].slot]) furniture_changed = true;
         }
-        break;
     }
-    case 6: {
-        fill_tile(px, py, light);
-        if (col == 0) {
-            for (int y2=0; y2<TILE_SIZE; y2++) { draw_pixel(px, py+y2, dark); draw_pixel(px+1, py+y2, mid); }
-            return;
-        }
-        if (col == 7) {
-            for (int y2=0; y2<TILE_SIZE; y2++) { draw_pixel(px+7, py+y2, dark); draw_pixel(px+6, py+y2, mid); }
-            return;
-        }
-        for (int x=0; x<TILE_SIZE; x++) {
-            draw_pixel(px+x, py+3, bright);
-            draw_pixel(px+x, py+4, mid); draw_pixel(px+x, py+5, mid);
-            draw_pixel(px+x, py+6, mid); draw_pixel(px+x, py+7, dark);
-        }
-        if (col % 2 == 0) { draw_pixel(px+3, py+5, dark); draw_pixel(px+4, py+5, dark); }
-        break;
+
+    if (floor_changed) {
+        if (!begin_layer(floor_page)) return false;
+        draw_floor_page(room);
+        end_layer();
     }
-    case 7: {
-        fill_tile(px, py, mid);
-        for (int x=0; x<TILE_SIZE; x++) draw_pixel(px+x, py+2, light);
-        for (int x=0; x<TILE_SIZE; x++) {
-            draw_pixel(px+x, py+5, dark); draw_pixel(px+x, py+6, dark); draw_pixel(px+x, py+7, dark);
-        }
-        if (col == 0) {
-            for (int y2=0; y2<TILE_SIZE; y2++) { draw_pixel(px, py+y2, dark); draw_pixel(px+1, py+y2, dark); }
-            draw_pixel(px, py, light); draw_pixel(px+1, py, light);
-        }
-        if (col == 7) {
-            for (int y2=0; y2<TILE_SIZE; y2++) { draw_pixel(px+6, py+y2, dark); draw_pixel(px+7, py+y2, dark); }
-            draw_pixel(px+6, py, light); draw_pixel(px+7, py, light);
-        }
-        if (col > 0 && col < 7) {
-            draw_pixel(px+3, py+1, dark); draw_pixel(px+5, py+3, dark);
-        }
-        break;
+    if (furniture_changed) {
+        if (!begin_layer(furniture_page)) return false;
+        draw_furniture_page(room);
+        end_layer();
     }
+    return true;
+}
+
+// Bring the chunks in view up to date and queue them for compositing;
+// false if render targets are unusable
+static bool render_room_layers(Room *room) {
+    if (!create_pages()) return false;
+    plan_chunks(room);
+    if (!draw_chunks(room)) {
+        chunks_clear();  // Partly drawn; bake everything again next time
+        return false;
+    }
+
+    for (int i = 0; i < view_chunk_count; i++) {
+        const ChunkRef *c = &view_chunks[i];
+        SDL_Point o = slot_origin(c->slot);
+        SDL_Rect src = {o.x + c->bounds.x - c->cx * CHUNK_PX, o.y + c->bounds.y - c->cy * CHUNK_PX,
+                        c->bounds.w, c->bounds.h};
+        SDL_Rect dst = {c->bounds.x - camera.x, c->bounds.y - camera.y, c->bounds.w, c->bounds.h};
+        cmd_copy(CMD_LAYER_WORLD, floor_page, &src, &dst);
+        if (slot_furniture[c->slot]) cmd_copy(CMD_LAYER_FURNITURE, furniture_page, &src, &dst);
     }
+    return true;
 }
 
-// Draw cat bed - 3 tiles wide, 3 tiles tall, variant = row*3 + col
-static void draw_catbed(int px, int py, int variant) {
-    int col = variant % 3;
-    int row = variant / 3;
-
-    Color dark = PALETTE[0];
-    Color mid = PALETTE[1];
-    Color light = PALETTE[2];
-    Color bright = PALETTE[3];
-
-    fill_tile(px, py, dark);
-
-    if (row == 0) {
-        if (col == 0) {
-            draw_pixel(px+4,py+3,mid); draw_pixel(px+5,py+3,mid);
-            draw_pixel(px+3,py+4,mid); draw_pixel(px+4,py+4,light);
-            draw_pixel(px+5,py+4,light); draw_pixel(px+6,py+4,mid);
-            draw_pixel(px+2,py+5,mid); draw_pixel(px+3,py+5,light);
-            draw_pixel(px+4,py+5,bright); draw_pixel(px+5,py+5,bright);
-            draw_pixel(px+6,py+5,light); draw_pixel(px+7,py+5,mid);
-            draw_pixel(px+2,py+6,mid); draw_pixel(px+3,py+6,light);
-            draw_pixel(px+4,py+6,bright); draw_pixel(px+5,py+6,bright);
-            draw_pixel(px+6,py+6,light); draw_pixel(px+7,py+6,mid);
-            draw_pixel(px+1,py+7,mid); draw_pixel(px+2,py+7,light);
-            draw_pixel(px+3,py+7,light); draw_pixel(px+4,py+7,mid);
-            draw_pixel(px+5,py+7,mid); draw_pixel(px+6,py+7,mid);
-            draw_pixel(px+7,py+7,mid);
-        } else if (col == 1) {
-            for (int x=0; x<TILE_SIZE; x++) {
-                draw_pixel(px+x, py+2, mid); draw_pixel(px+x, py+3, light);
-                draw_pixel(px+x, py+4, bright); draw_pixel(px+x, py+5, light);
-                draw_pixel(px+x, py+6, mid); draw_pixel(px+x, py+7, mid);
-            }
-        } else {
-            draw_pixel(px+2,py+3,mid); draw_pixel(px+3,py+3,mid);
-            draw_pixel(px+1,py+4,mid); draw_pixel(px+2,py+4,light);
-            draw_pixel(px+3,py+4,light); draw_pixel(px+4,py+4,mid);
-            draw_pixel(px+0,py+5,mid); draw_pixel(px+1,py+5,light);
-            draw_pixel(px+2,py+5,bright); draw_pixel(px+3,py+5,bright);
-            draw_pixel(px+4,py+5,light); draw_pixel(px+5,py+5,mid);
-            draw_pixel(px+0,py+6,mid); draw_pixel(px+1,py+6,light);
-            draw_pixel(px+2,py+6,bright); draw_pixel(px+3,py+6,bright);
-            draw_pixel(px+4,py+6,light); draw_pixel(px+5,py+6,mid);
-            draw_pixel(px+0,py+7,mid); draw_pixel(px+1,py+7,mid);
-            draw_pixel(px+2,py+7,mid); draw_pixel(px+3,py+7,mid);
-            draw_pixel(px+4,py+7,light); draw_pixel(px+5,py+7,light);
-            draw_pixel(px+6,py+7,mid);
-        }
-    } else if (row == 1) {
-        if (col == 0) {
-            draw_pixel(px+0,py+0,mid); draw_pixel(px+1,py+0,light);
-            draw_pixel(px+2,py+0,light); draw_pixel(px+3,py+0,mid);
-            for (int y2=1; y2<7; y2++) {
-                draw_pixel(px, py+y2, mid); draw_pixel(px+1, py+y2, light);
-                draw_pixel(px+2, py+y2, mid);
-            }
-            draw_pixel(px+0,py+7,mid); draw_pixel(px+1,py+7,light);
-            draw_pixel(px+2,py+7,light); draw_pixel(px+3,py+7,mid);
-            for (int y2=0; y2<TILE_SIZE; y2++)
-                for (int x=4; x<TILE_SIZE; x++) draw_pixel(px+x, py+y2, mid);
-            draw_pixel(px+4,py+5,dark); draw_pixel(px+5,py+5,dark);
-            draw_pixel(px+5,py+4,dark); draw_pixel(px+6,py+4,dark);
-            draw_pixel(px+7,py+4,dark); draw_pixel(px+7,py+3,dark);
-        } else if (col == 1) {
-            fill_tile(px, py, mid);
-            draw_pixel(px+1,py+0,dark); draw_pixel(px+2,py+0,dark);
-            draw_pixel(px+5,py+0,dark); draw_pixel(px+6,py+0,dark);
-            for (int x=1; x<=6; x++) draw_pixel(px+x, py+1, dark);
-            draw_pixel(px+2,py+2,dark); draw_pixel(px+3,py+2,mid);
-            draw_pixel(px+4,py+2,mid); draw_pixel(px+5,py+2,dark);
-            for (int x=0; x<TILE_SIZE; x++) {
-                draw_pixel(px+x, py+3, dark); draw_pixel(px+x, py+4, dark);
-            }
-            for (int x=0; x<=6; x++) draw_pixel(px+x, py+5, dark);
-            draw_pixel(px+2,py+6,dark); draw_pixel(px+3,py+6,dark);
-            draw_pixel(px+5,py+6,dark);
-            draw_pixel(px+0,py+6,dark);
-            draw_pixel(px+0,py+7,dark); draw_pixel(px+1,py+7,dark);
-            draw_pixel(px+2,py+7,dark);
-        } else {
-            draw_pixel(px+4,py+0,mid); draw_pixel(px+5,py+0,light);
-            draw_pixel(px+6,py+0,light); draw_pixel(px+7,py+0,mid);
-            for (int y2=1; y2<7; y2++) {
-                draw_pixel(px+5, py+y2, mid); draw_pixel(px+6, py+y2, light);
-                draw_pixel(px+7, py+y2, mid);
-            }
-            draw_pixel(px+4,py+7,mid); draw_pixel(px+5,py+7,light);
-            draw_pixel(px+6,py+7,light); draw_pixel(px+7,py+7,mid);
-            for (int y2=0; y2<TILE_SIZE; y2++)
-                for (int x=0; x<4; x++) draw_pixel(px+x, py+y2, mid);
-            draw_pixel(px+0,py+3,dark); draw_pixel(px+0,py+4,dark);
-            draw_pixel(px+1,py+4,dark); draw_pixel(px+0,py+5,dark);
-        }
-    } else {
-        if (col == 0) {
-            draw_pixel(px+1,py+0,mid); draw_pixel(px+2,py+0,light);
-            draw_pixel(px+3,py+0,mid); draw_pixel(px+4,py+0,mid);
-            draw_pixel(px+5,py+0,mid); draw_pixel(px+6,py+0,mid);
-            draw_pixel(px+7,py+0,mid);
-            draw_pixel(px+2,py+1,mid); draw_pixel(px+3,py+1,light);
-            draw_pixel(px+4,py+1,bright); draw_pixel(px+5,py+1,bright);
-            draw_pixel(px+6,py+1,light); draw_pixel(px+7,py+1,mid);
-            draw_pixel(px+2,py+2,mid); draw_pixel(px+3,py+2,light);
-            draw_pixel(px+4,py+2,bright); draw_pixel(px+5,py+2,bright);
-            draw_pixel(px+6,py+2,light); draw_pixel(px+7,py+2,mid);
-            draw_pixel(px+3,py+3,mid); draw_pixel(px+4,py+3,light);
-            draw_pixel(px+5,py+3,light); draw_pixel(px+6,py+3,mid);
-            draw_pixel(px+4,py+4,mid); draw_pixel(px+5,py+4,mid);
-        } else if (col == 1) {
-            for (int x=0; x<TILE_SIZE; x++) {
-                draw_pixel(px+x, py+0, mid); draw_pixel(px+x, py+1, mid);
-                draw_pixel(px+x, py+2, light); draw_pixel(px+x, py+3, bright);
-                draw_pixel(px+x, py+4, light); draw_pixel(px+x, py+5, mid);
-            }
-        } else {
-            draw_pixel(px+0,py+0,mid); draw_pixel(px+1,py+0,mid);
-            draw_pixel(px+2,py+0,mid); draw_pixel(px+3,py+0,mid);
-            draw_pixel(px+4,py+0,mid); draw_pixel(px+5,py+0,light);
-            draw_pixel(px+6,py+0,mid);
-            draw_pixel(px+0,py+1,mid); draw_pixel(px+1,py+1,light);
-            draw_pixel(px+2,py+1,bright); draw_pixel(px+3,py+1,bright);
-            draw_pixel(px+4,py+1,light); draw_pixel(px+5,py+1,mid);
-            draw_pixel(px+0,py+2,mid); draw_pixel(px+1,py+2,light);
-            draw_pixel(px+2,py+2,bright); draw_pixel(px+3,py+2,bright);
-            draw_pixel(px+4,py+2,light); draw_pixel(px+5,py+2,mid);
-            draw_pixel(px+1,py+3,mid); draw_pixel(px+2,py+3,light);
-            draw_pixel(px+3,py+3,light); draw_pixel(px+4,py+3,mid);
-            draw_pixel(px+2,py+4,mid); draw_pixel(px+3,py+4,mid);
+static void draw_actor(int index) {
+    SDL_Rect src = atlas_player_rect();
+    SDL_Rect dst = {actors[index].x - camera.x, actors[index].y - camera.y,
+                    PLAYER_SIZE, PLAYER_SIZE};
+    cmd_copy(CMD_LAYER_ACTORS, atlas_texture(), &src, &dst);
+    g_frame_stats.tiles++;
+}
+
+// Without render targets the room is drawn straight from the atlas, in the
+// same way as the chunks: sprites of the objects in view, then the rest
+static void draw_room_direct(const Room *room) {
+    TileRect view = clip_rect(visible_tiles(), room_bounds(room));
+    bool intact[ROOM_MAX_OBJECTS];
+    find_intact(room, view, intact);
+    for (int i = 0; i < room->object_count; i++) {
+        if (!intact[i]) continue;
+        SDL_Rect sprite = atlas_sprite_rect((TileType)room->objects[i].type);
+        SDL_Rect src, dst;
+        sprite_part(&room->objects[i], view, &src, &dst);
+        src.x += sprite.x;
+        src.y += sprite.y;
+        dst.x -= camera.x;
+        dst.y -= camera.y;
+        cmd_copy(CMD_LAYER_WORLD, atlas_texture(), &src, &dst);
+        g_frame_stats.tiles++;
+    }
+    for (int y = view.y; y < view.y + view.h; y++) {
+        for (int x = view.x; x < view.x + view.w; x++) {
+            if (in_sprite(room, intact, x, y)) continue;
+            const Tile *tile = room_tile(room, x, y);
+            draw_tile(CMD_LAYER_WORLD, x, y, (TileType)tile->type, room_tile_variant(room, x, y));
         }
     }
 }
 
-void render_tile(int tile_x, int tile_y, const Tile *tile) {
-    int px = tile_x * TILE_SIZE;
-    int py = tile_y * TILE_SIZE;
-    
-    switch (tile->type) {
-        case TILE_FLOOR:
-            draw_floor(px, py, tile->variant);
-            break;
-        case TILE_WALL:
-            draw_wall(px, py, tile->variant);
-            break;
-        case TILE_DOOR:
-            draw_door(px, py, tile->variant);
-            break;
-        case TILE_COUCH:
-            draw_couch(px, py, tile->variant);
-            break;
-        case TILE_DESK:
-            draw_desk(px, py, tile->variant);
-            break;
-        case TILE_LAPTOP:
-            draw_laptop(px, py, tile->variant);
-            break;
-        case TILE_BOOKSHELF:
-            draw_bookshelf(px, py, tile->variant);
-            break;
-        case TILE_RUG:
-            draw_rug(px, py, tile->variant);
-            break;
-        case TILE_TV:
-            draw_tv(px, py, tile->variant);
-            break;
-        case TILE_COFFEE_TABLE:
-            draw_coffee_table(px, py, tile->variant);
-            break;
-        case TILE_COUNTER:
-            draw_counter(px, py, tile->variant);
-            break;
-        case TILE_FRIDGE:
-            draw_fridge(px, py, tile->variant);
-            break;
-        case TILE_CATBED:
-            draw_catbed(px, py, tile->variant);
-            break;
-        case TILE_PLANT:
-            draw_plant(px, py, tile->variant);
-            break;
-        case TILE_BED:
-            draw_bed(px, py, tile->variant);
-            break;
-        case TILE_NIGHTSTAND:
-            draw_nightstand(px, py, tile->variant);
-            break;
-        case TILE_INTERIOR_WALL:
-            draw_interior_wall(px, py, tile->variant);
-            break;
-        default:
-            fill_tile(px, py, PALETTE[2]);
-            break;
+static void clear_screen(void) {
+    SDL_SetRenderDrawColor(g_game.renderer, PALETTE[0].r, PALETTE[0].g, PALETTE[0].b, 255);
+    SDL_RenderClear(g_game.renderer);
+    g_frame_stats.color_changes++;
+    g_frame_stats.draw_calls++;
+}
+
+bool render_prefetch(Room *room, int px, int py) {
+    if (!create_pages()) return false;
+    cmd_begin(g_game.renderer);
+    bool missing = plan_prefetch(room, px, py);
+    if (!draw_chunks(room)) {
+        chunks_clear();
+        return false;
     }
+    return missing;
 }
 
-void render_room(const Room *room) {
-    for (int y = 0; y < GRID_HEIGHT; y++) {
-        for (int x = 0; x < GRID_WIDTH; x++) {
-            render_tile(x, y, &room->tiles[y][x]);
-        }
+// The screen cannot be read back cheaply, so the frame last shown is drawn
+// again into a texture: same room, camera and player position
+void render_begin_transition(void) {
+    fading = false;
+    fade_start = g_game.frame;
+    Room *room = screen_room;
+    if (!room || screen_stale || !create_pages()) return;  // Cut instead
+    if (!fade_texture) {
+        fade_texture = SDL_CreateTexture(g_game.renderer, SDL_PIXELFORMAT_ARGB8888,
+                                         SDL_TEXTUREACCESS_TARGET, WINDOW_WIDTH, WINDOW_HEIGHT);
+        if (!fade_texture) return;
+        SDL_SetTextureBlendMode(fade_texture, SDL_BLENDMODE_BLEND);
     }
+
+    cmd_begin(g_game.renderer);
+    camera = camera_at(room, screen_player);
+    if (!render_room_layers(room) || !begin_layer(fade_texture)) {
+        cmd_begin(g_game.renderer);  // Drop the queued composite
+        return;
+    }
+    clear_screen();
+    collect_actors(screen_player);
+    render_actors(room);
+    end_layer();
+    fading = true;
+}
+
+bool render_init(void) {
+    screen_stale = true;
+    return init_chunks(SLOT_BYTES);  // The pages are created on first use
+}
+
+void render_invalidate(void) {
+    chunks_clear();
+    screen_stale = true;
+    fading = false;  // The old room's frame went with the targets
+}
+
+void render_shutdown(void) {
+    destroy_pages();
+    chunks_shutdown();
+    if (fade_texture) SDL_DestroyTexture(fade_texture);
+    fade_texture = NULL;
+    fading = false;
 }
 
 void render_frame(void) {
-    // Clear
-    SDL_SetRenderDrawColor(g_game.renderer, PALETTE[0].r, PALETTE[0].g, PALETTE[0].b, 255);
-    SDL_RenderClear(g_game.renderer);
-    
-    // Render current room
-    if (g_game.current_room) {
-        render_room(g_game.current_room);
+    cmd_begin(g_game.renderer);
+
+    // The chunks cover the screen unless the room is smaller than it, so
+    // only then, or for the fallback (straight from the atlas if targets
+    // are unavailable), is a clear needed
+    Room *room = g_game.current_room;
+    bool cached = false;
+    if (room) {
+        update_camera(room);
+        cached = render_room_layers(room);
     }
-    
-    SDL_RenderPresent(g_game.renderer);
+    if (!cached || !room_covers_screen(room)) {
+        clear_screen();
+    }
+    if (room && !cached) {
+        draw_room_direct(room);
+        room_clear_dirty(room);
+    }
+    if (room) {
+        collect_actors(player_world_pos());
+        render_actors(room);
+    }
+    if (fading) {
+        float left = fade_left();
+        if (left > 0.0f) cmd_copy_alpha(CMD_LAYER_OVERLAY, fade_texture, NULL, NULL,
+                                        (uint8_t)(left * 255.0f + 0.5f));
+        fading = left > 0.0f;
+    }
+
+    if (stats_overlay_visible()) {
+        stats_draw_overlay();
+    }
+    cmd_flush();
+    screen_drawn();
+}
+
+#endif // RENDER_GL / RENDER_SOFTWARE
+
+void render_present(void) {
+    platform_present();
 }
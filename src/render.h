@@ -1,5 +1,5 @@
 /**
- * render.h - Drawing primitives and rendering
+ * render.h - Room rendering
  */
 
 #ifndef RENDER_H
@@ -7,8 +7,28 @@
 
 #include "game.h"
 
+// Set up the backend (after atlas_init); RENDER_SOFTWARE selects the
+// indexed framebuffer, otherwise tiles are blitted with SDL_Renderer
+bool render_init(void);
+void render_shutdown(void);
 void render_frame(void);
-void render_room(const Room *room);
-void render_tile(int tile_x, int tile_y, const Tile *tile);
+void render_present(void);
+
+// Drop cached room rendering (e.g. after the render targets were lost)
+void render_invalidate(void);
+
+// True if render_frame() would change the screen: nothing drawn yet, the
+// room switched or was invalidated, tiles are dirty, the player moved, or
+// the HUD is shown
+bool render_pending(void);
+
+// Bake a few chunks of the view a player at world pixel (px, py) would
+// see in a room that is not on screen, into slots the current room has
+// not used lately. Call once per frame; true while chunks are missing.
+bool render_prefetch(Room *room, int px, int py);
+
+// Call just before switching rooms: the frame last shown fades out over
+// the new room during the next frames
+void render_begin_transition(void);
 
 #endif // RENDER_H
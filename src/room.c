@@ -3,17 +3,457 @@
  */
 
 #include "room.h"
+#include "roomfile.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-// Forward declarations for room initializers (defined in rooms/*.c)
+// Where .room assets live: the preloaded package on web, the build
+// output next to the binary natively
+#ifndef ROOM_ASSET_DIR
+#ifdef __EMSCRIPTEN__
+#define ROOM_ASSET_DIR "/rooms"
+#else
+#define ROOM_ASSET_DIR "build/rooms"
+#endif
+#endif
+
+// Builders (rooms/*.c) are only linked with ROOMS_BUILDER; release builds
+// use the tables and .room files that tools/roompack.c bakes from them
+#ifdef ROOMS_BUILDER
 void init_room_home(Room *room);
+void init_room_library(Room *room);
+#define BUILDER(fn) fn
+#else
+#define BUILDER(fn) NULL
+#endif
+
+typedef struct {
+    const char *name;
+    const char *asset;
+    bool resident;
+    int width, height;          // Size the builder fills, in tiles
+    void (*build)(Room *room);
+} RoomInfo;
+
+// Resident rooms are compiled in; keep the flag for rooms needed at startup
+static const RoomInfo ROOM_INFO[ROOM_COUNT] = {
+    [ROOM_HOME] = { "Home", "home.room", true, GRID_WIDTH, GRID_HEIGHT, BUILDER(init_room_home) },
+    [ROOM_LIBRARY] = { "Library", "library.room", false, 50, 120, BUILDER(init_room_library) },
+};
+
+// Grouped by room; entry indices are into the target room's entry points
+static const RoomDoor ROOM_DOORS[] = {
+    { ROOM_HOME, 0, ROOM_LIBRARY, 0 },
+    { ROOM_LIBRARY, 0, ROOM_HOME, 0 },
+};
+
+// Heap budget for loaded rooms' tiles and bitsets (make ROOM_BUDGET_KB=...);
+// baked rooms cost only their bitsets until their tiles are first changed
+#ifndef ROOM_BUDGET_KB
+#define ROOM_BUDGET_KB 512
+#endif
+
+// Room storage; each room is bound or decoded on first entry
+static Room rooms[ROOM_COUNT];
+static bool loaded[ROOM_COUNT];
+static RoomId current = ROOM_HOME;
+static uint32_t entered[ROOM_COUNT];    // Clock of the last room_enter()
+static uint32_t enter_clock = 0;
+static uint32_t load_serial = 0;
+
+#ifdef ROOMS_BUILDER
+void room_build(RoomId id, Room *room) {
+    memset(room, 0, sizeof(*room));
+    if (!room_alloc(room, ROOM_INFO[id].width, ROOM_INFO[id].height)) return;
+    ROOM_INFO[id].build(room);
+    room->name = ROOM_INFO[id].name;
+    room_clear_dirty(room);
+}
+#endif
+
+// Row y of one of a room's bitsets
+static uint64_t *bit_row(const Room *room, uint64_t *bits, int y) {
+    return bits + (size_t)y * room->row_words;
+}
 
-// Room storage
-static Room home_room = {0};
+static void set_bit(uint64_t *row, int x, bool on) {
+    if (on) row[x >> 6] |= 1ull << (x & 63);
+    else row[x >> 6] &= ~(1ull << (x & 63));
+}
+
+// Cleared dirty and solid bitsets for a width × height room, as one block
+// (dirty rows, then solid rows)
+static bool alloc_bits(Room *room, int width, int height) {
+    int row_words = (width + 63) / 64;
+    uint64_t *bits = calloc(2 * (size_t)height * row_words, sizeof(uint64_t));
+    if (!bits) {
+        fprintf(stderr, "room: out of memory\n");
+        return false;
+    }
+    free(room->dirty);
+    room->dirty = bits;
+    room->solid = bits + (size_t)height * row_words;
+    room->row_words = row_words;
+    return true;
+}
+
+// Collision for one cell. The top row of TALL furniture is walkable: an
+// actor standing there is behind the object, and the renderer draws the
+// object's front over it.
+static bool cell_solid(const Room *room, int y, const Tile *tile) {
+    if (!tile_is_solid((TileType)tile->type)) return false;
+    if (!(TILE_INFO[tile->type].flags & TILE_FLAG_TALL) || tile->variant >= room->object_count) {
+        return true;
+    }
+    return room->objects[tile->variant].y != y;
+}
+
+// Derive the whole collision bitset from the tiles (after a load)
+static void room_update_solid(Room *room) {
+    memset(room->solid, 0, (size_t)room->height * room->row_words * sizeof(uint64_t));
+    for (int y = 0; y < room->height; y++) {
+        for (int x = 0; x < room->width; x++) {
+            if (cell_solid(room, y, room_tile(room, x, y))) set_bit(bit_row(room, room->solid, y), x, true);
+        }
+    }
+}
+
+static bool room_load(RoomId id, Room *room) {
+#ifdef ROOMS_BUILDER
+    room_build(id, room);
+    if (!room->tiles) return false;
+#else
+    memset(room, 0, sizeof(*room));
+    const BakedRoom *baked = &BAKED_ROOMS[id];
+    if (baked->tiles) {
+        // Point at the read-only tables; only the small lists are copied
+        room->tiles = baked->tiles;
+        room->width = baked->width;
+        room->height = baked->height;
+        memcpy(room->objects, baked->objects, baked->object_count * sizeof(RoomObject));
+        room->object_count = baked->object_count;
+        memcpy(room->entries, baked->entries, baked->entry_count * sizeof(RoomEntry));
+        room->entry_count = baked->entry_count;
+        if (!alloc_bits(room, room->width, room->height)) return false;
+    } else {
+        char path[256];
+        snprintf(path, sizeof(path), "%s/%s", ROOM_ASSET_DIR, ROOM_INFO[id].asset);
+        if (!roomfile_load(path, room)) return false;
+    }
+    room->name = ROOM_INFO[id].name;
+#endif
+    room_update_solid(room);
+    return true;
+}
 
 void rooms_init(void) {
-    init_room_home(&home_room);
+    memset(loaded, 0, sizeof(loaded));
+    memset(entered, 0, sizeof(entered));
+    current = ROOM_HOME;
+}
+
+static size_t bits_size(const Room *room) {
+    return 2 * (size_t)room->height * room->row_words * sizeof(uint64_t);
+}
+
+static size_t room_heap(const Room *room) {
+    size_t heap = room->dirty ? bits_size(room) : 0;
+    if (room->storage) heap += (size_t)room->width * room->height * sizeof(Tile);
+    return heap;
+}
+
+static bool room_pinned(RoomId id) {
+    if (id == current) return true;
+    const RoomDoor *doors;
+    int count = room_doors(current, &doors);
+    for (int i = 0; i < count; i++) {
+        if (doors[i].to == id) return true;
+    }
+    return false;
+}
+
+// Unload unpinned rooms other than keep until the loaded ones fit the
+// budget (or nothing else can go)
+static void rooms_trim(RoomId keep) {
+    size_t budget = (size_t)ROOM_BUDGET_KB * 1024, total = 0;
+    for (int i = 0; i < ROOM_COUNT; i++) {
+        if (loaded[i]) total += room_heap(&rooms[i]);
+    }
+    while (total > budget) {
+        int victim = -1;
+        for (int i = 0; i < ROOM_COUNT; i++) {
+            if (!loaded[i] || i == (int)keep || room_pinned((RoomId)i) || !room_heap(&rooms[i])) continue;
+            if (victim < 0 || entered[i] < entered[victim]) victim = i;
+        }
+        if (victim < 0) break;
+        total -= room_heap(&rooms[victim]);
+        room_free(&rooms[victim]);
+        loaded[victim] = false;
+    }
+}
+
+int room_count(void) {
+    return ROOM_COUNT;
+}
+
+Room* room_get(int index) {
+    if (index < 0 || index >= ROOM_COUNT) return NULL;
+    if (!loaded[index]) {
+        if (!room_load((RoomId)index, &rooms[index])) return NULL;
+        rooms[index].serial = ++load_serial;
+        loaded[index] = true;
+        rooms_trim((RoomId)index);
+    }
+    return &rooms[index];
+}
+
+Room* room_peek(RoomId id) {
+    return id < ROOM_COUNT && loaded[id] ? &rooms[id] : NULL;
 }
 
 Room* room_get_home(void) {
-    return &home_room;
+    return room_get(ROOM_HOME);
+}
+
+RoomId room_id(const Room *room) {
+    if (room < rooms || room >= rooms + ROOM_COUNT) return ROOM_COUNT;
+    return (RoomId)(room - rooms);
+}
+
+void room_enter(RoomId id) {
+    current = id;
+    entered[id] = ++enter_clock;
+    rooms_trim(id);
+}
+
+int room_doors(RoomId id, const RoomDoor **doors) {
+    int count = 0;
+    *doors = NULL;
+    for (size_t i = 0; i < sizeof(ROOM_DOORS) / sizeof(ROOM_DOORS[0]); i++) {
+        if (ROOM_DOORS[i].room != id) continue;
+        if (!*doors) *doors = &ROOM_DOORS[i];
+        count++;
+    }
+    return count;
+}
+
+const RoomDoor* room_door_at(const Room *room, int px, int py, int w, int h) {
+    const RoomDoor *doors;
+    int count = room_doors(room_id(room), &doors);
+    int door = 0;
+    for (int i = 0; i < room->object_count && count > 0; i++) {
+        const RoomObject *obj = &room->objects[i];
+        if (obj->type != TILE_DOOR) continue;
+        int ox = obj->x * TILE_SIZE, oy = obj->y * TILE_SIZE;
+        bool hit = px < ox + obj->w * TILE_SIZE && px + w > ox &&
+                   py < oy + obj->h * TILE_SIZE && py + h > oy;
+        for (int d = 0; d < count && hit; d++) {
+            if (doors[d].door == door) return &doors[d];
+        }
+        door++;
+    }
+    return NULL;
+}
+
+const char* room_asset_name(RoomId id) {
+    return ROOM_INFO[id].asset;
+}
+
+bool room_is_resident(RoomId id) {
+    return ROOM_INFO[id].resident;
+}
+
+bool room_alloc(Room *room, int width, int height) {
+    if (width <= 0 || height <= 0 || width > ROOM_MAX_WIDTH || height > ROOM_MAX_HEIGHT) {
+        fprintf(stderr, "room: %dx%d is not a valid room size\n", width, height);
+        return false;
+    }
+    Tile *storage = calloc((size_t)width * height, sizeof(Tile));
+    if (!storage) {
+        fprintf(stderr, "room: out of memory\n");
+        return false;
+    }
+    if (!alloc_bits(room, width, height)) {
+        free(storage);
+        return false;
+    }
+    room->width = width;
+    room->height = height;
+    free(room->storage);
+    room->storage = storage;
+    room->tiles = storage;
+    return true;
+}
+
+void room_free(Room *room) {
+    if (room->tiles == room->storage) room->tiles = NULL;
+    free(room->storage);
+    free(room->dirty);
+    room->storage = NULL;
+    room->dirty = room->solid = NULL;
+}
+
+void room_set_tile(Room *room, int x, int y, TileType type, uint8_t variant) {
+    if (!room->tiles || !room_contains(room, x, y)) return;
+    const Tile *current = room_tile(room, x, y);
+    if (current->type == type && current->variant == variant) return;
+
+    // Copy-on-write: baked rooms share read-only tiles until first changed
+    if (room->tiles != room->storage) {
+        size_t size = (size_t)room->width * room->height * sizeof(Tile);
+        Tile *storage = room->storage ? room->storage : malloc(size);
+        if (!storage) {
+            fprintf(stderr, "room: out of memory\n");
+            return;
+        }
+        memcpy(storage, room->tiles, size);
+        room->storage = storage;
+        room->tiles = storage;
+    }
+    Tile *tile = &room->storage[y * room->width + x];
+    tile->type = type;
+    tile->variant = variant;
+    set_bit(bit_row(room, room->dirty, y), x, true);
+    set_bit(bit_row(room, room->solid, y), x, cell_solid(room, y, tile));
+}
+
+bool room_box_walkable(const Room *room, int px, int py, int w, int h) {
+    if (w <= 0 || h <= 0) return true;
+    if (px < 0 || py < 0) return false;
+    if (px + w > room->width * TILE_SIZE || py + h > room->height * TILE_SIZE) return false;
+
+    int x0 = px / TILE_SIZE, x1 = (px + w - 1) / TILE_SIZE;
+    int y0 = py / TILE_SIZE, y1 = (py + h - 1) / TILE_SIZE;
+
+    uint64_t hit = 0;
+    for (int word = x0 >> 6; word <= x1 >> 6; word++) {
+        int lo = word == x0 >> 6 ? x0 & 63 : 0;
+        int hi = word == x1 >> 6 ? x1 & 63 : 63;
+        uint64_t mask = (hi - lo == 63 ? ~0ull : (1ull << (hi - lo + 1)) - 1) << lo;
+        for (int y = y0; y <= y1; y++) hit |= bit_row(room, room->solid, y)[word] & mask;
+    }
+    return hit == 0;
+}
+
+int room_add_object(Room *room, TileType type, int x, int y, int w, int h) {
+    if (room->object_count == ROOM_MAX_OBJECTS) return -1;
+    room->objects[room->object_count] = (RoomObject){
+        (uint8_t)type, (uint16_t)x, (uint16_t)y, (uint16_t)w, (uint16_t)h
+    };
+    return room->object_count++;
+}
+
+void room_add_entry(Room *room, int x, int y) {
+    if (room->entry_count == ROOM_MAX_ENTRIES) return;
+    room->entries[room->entry_count++] = (RoomEntry){(uint16_t)x, (uint16_t)y};
+}
+
+// Variant of the tile at (col, row) of a w×h placement whose origin is (x, y)
+// (sprite types store their object index instead, see room_place_area)
+static uint8_t placed_variant(const TileInfo *info, int x, int y,
+                              int col, int row, int w, int h) {
+    switch (info->encoding) {
+        case VARIANT_PARITY:
+            return (uint8_t)((x + col + y + row) % 2);
+        case VARIANT_EDGES:
+            return (uint8_t)((row == 0 ? 1 : 0) | (row == h - 1 ? 2 : 0) |
+                             (col == 0 ? 4 : 0) | (col == w - 1 ? 8 : 0));
+        default:
+            return 0;
+    }
+}
+
+void room_place(Room *room, TileType type, int x, int y) {
+    const TileInfo *info = &TILE_INFO[type];
+    room_place_area(room, type, x, y, info->width, info->height);
+}
+
+void room_place_area(Room *room, TileType type, int x, int y, int w, int h) {
+    const TileInfo *info = &TILE_INFO[type];
+    int index = -1;
+    if (tile_is_sprite(type)) {
+        w = info->width;  // Sprites always cover their registry footprint
+        h = info->height;
+    }
+    if (info->flags & TILE_FLAG_OBJECT) {
+        index = room_add_object(room, type, x, y, w, h);
+        if (index < 0 && tile_is_sprite(type)) return;  // Cells need their object
+    }
+    for (int row = 0; row < h; row++) {
+        for (int col = 0; col < w; col++) {
+            uint8_t variant = tile_is_sprite(type)
+                ? (uint8_t)index
+                : placed_variant(info, x, y, col, row, w, h);
+            room_set_tile(room, x + col, y + row, type, variant);
+        }
+    }
+}
+
+bool room_has_dirty(const Room *room) {
+    uint64_t any = 0;
+    size_t words = (size_t)room->height * room->row_words;
+    for (size_t i = 0; i < words; i++) any |= room->dirty[i];
+    return any != 0;
+}
+
+// First bit at or after x that is set (or clear) in a bitset row of
+// words words; words * 64 if there is none
+static int row_find(const uint64_t *row, int words, int x, bool set) {
+    for (int w = x >> 6; w < words; w++) {
+        uint64_t bits = set ? row[w] : ~row[w];
+        if (w == x >> 6) bits &= ~0ull << (x & 63);
+        if (bits) return w * 64 + __builtin_ctzll(bits);
+    }
+    return words * 64;
+}
+
+int room_take_dirty(Room *room, TileRect *rects, int max) {
+    int count = 0;
+    bool overflow = false;
+    int min_x = room->width, max_x = 0, min_y = room->height, max_y = 0;
+
+    for (int y = 0; y < room->height; y++) {
+        // Split the row into runs of consecutive dirty tiles
+        // Bits past the room's width are never set, so runs end inside it
+        const uint64_t *row = bit_row(room, room->dirty, y);
+        int words = room->row_words, w;
+        for (int x0 = row_find(row, words, 0, true); x0 < room->width;
+             x0 = row_find(row, words, x0 + w, true)) {
+            w = row_find(row, words, x0, false) - x0;
+
+            if (x0 < min_x) min_x = x0;
+            if (x0 + w > max_x) max_x = x0 + w;
+            if (y < min_y) min_y = y;
+            max_y = y + 1;
+
+            // Extend a rect ending on the previous row with the same span
+            bool merged = false;
+            for (int i = 0; i < count; i++) {
+                if (rects[i].x == x0 && rects[i].w == w && rects[i].y + rects[i].h == y) {
+                    rects[i].h++;
+                    merged = true;
+                    break;
+                }
+            }
+            if (merged) continue;
+            if (count == max) {
+                overflow = true;
+                continue;
+            }
+            rects[count++] = (TileRect){x0, y, w, 1};
+        }
+    }
+
+    room_clear_dirty(room);
+
+    if (overflow && max > 0) {
+        rects[0] = (TileRect){min_x, min_y, max_x - min_x, max_y - min_y};
+        return 1;
+    }
+    return count;
+}
+
+void room_clear_dirty(Room *room) {
+    if (room->dirty) memset(room->dirty, 0, (size_t)room->height * room->row_words * sizeof(uint64_t));
 }
@@ -5,12 +5,138 @@
 #ifndef ROOM_H
 #define ROOM_H
 
-#include "game.h"
+#include "tiles.h"
 
-// Initialize all rooms
+typedef enum {
+    ROOM_HOME = 0,
+    ROOM_LIBRARY,
+    ROOM_COUNT
+} RoomId;
+
+// Door graph: walking onto the door-th TILE_DOOR object of a room (in
+// placement order) leads to an entry point of another room
+typedef struct {
+    RoomId room;
+    int door;
+    RoomId to;
+    int entry;
+} RoomDoor;
+
+// Reset room storage; rooms are loaded lazily on first room_get()
 void rooms_init(void);
 
+// Enumerate all registered rooms (loads the room if needed; NULL on failure)
+int room_count(void);
+Room* room_get(int index);
+
+// A room if it is loaded, without loading it
+Room* room_peek(RoomId id);
+
 // Get specific rooms
 Room* room_get_home(void);
 
+// Id of a registered room; ROOM_COUNT for any other Room
+RoomId room_id(const Room *room);
+
+// Make a room the current one. It and its door neighbours stay loaded;
+// other rooms are unloaded, least recently entered first, while the
+// loaded rooms' tiles and bitsets exceed ROOM_BUDGET_KB. An unloaded room forgets
+// runtime tile changes and is loaded from its asset again when needed.
+void room_enter(RoomId id);
+
+// Doors leading out of a room; *doors points into a static table
+int room_doors(RoomId id, const RoomDoor **doors);
+
+// The door whose object overlaps a box in pixels, or NULL
+const RoomDoor* room_door_at(const Room *room, int px, int py, int w, int h);
+
+// Asset file name of a room (under ROOM_ASSET_DIR)
+const char* room_asset_name(RoomId id);
+
+// Resident rooms are compiled into the binary as const tables (see
+// BAKED_ROOMS); the others are streamed from their .room asset
+bool room_is_resident(RoomId id);
+
+// Room data compiled into read-only memory; generated by tools/roompack.c
+// into build/rooms_baked.c. Entries for streamed rooms have NULL tiles.
+typedef struct {
+    const Tile *tiles;
+    int width, height;
+    const RoomObject *objects;
+    int object_count;
+    const RoomEntry *entries;
+    int entry_count;
+} BakedRoom;
+
+#ifndef ROOMS_BUILDER
+extern const BakedRoom BAKED_ROOMS[ROOM_COUNT];
+#endif
+
+#ifdef ROOMS_BUILDER
+// Run a room's imperative builder (debug builds and tools/roompack.c)
+void room_build(RoomId id, Room *room);
+#endif
+
+// Read one tile (no bounds check; callers iterate within the room)
+static inline const Tile* room_tile(const Room *room, int x, int y) {
+    return &room->tiles[y * room->width + x];
+}
+
+static inline bool room_contains(const Room *room, int x, int y) {
+    return x >= 0 && x < room->width && y >= 0 && y < room->height;
+}
+
+// Visual variant of a tile: cells of sprite objects store the object's
+// index, which resolves to the cell's position within the object
+static inline int room_tile_variant(const Room *room, int x, int y) {
+    const Tile *tile = room_tile(room, x, y);
+    if (!tile_is_sprite((TileType)tile->type)) return tile->variant;
+    const RoomObject *obj = &room->objects[tile->variant];
+    return (y - obj->y) * obj->w + (x - obj->x);
+}
+
+// Give a room writable tiles of the given size (ROOM_MAX_* at most), all
+// floor variant 0, and its bitsets; false if too large or out of memory
+bool room_alloc(Room *room, int width, int height);
+
+// Free a room's tile storage and bitsets
+void room_free(Room *room);
+
+// Change one tile, mark it dirty for the renderer and update Room.solid.
+// For sprite types the variant must be the index of a covering object.
+void room_set_tile(Room *room, int x, int y, TileType type, uint8_t variant);
+
+// Collision lookup for one tile; anything outside the room is solid
+static inline bool room_is_solid(const Room *room, int x, int y) {
+    if (!room_contains(room, x, y)) return true;
+    return (room->solid[y * room->row_words + (x >> 6)] >> (x & 63)) & 1;
+}
+
+// True if a box in pixels overlaps no solid tile and lies inside the room.
+// Tests the Room.solid words of the tile rows covered, never the tile grid.
+bool room_box_walkable(const Room *room, int px, int py, int w, int h);
+
+// Record furniture and entry points (used by the builders); returns the
+// object's index, or -1 if the room is full
+int room_add_object(Room *room, TileType type, int x, int y, int w, int h);
+void room_add_entry(Room *room, int x, int y);
+
+// Place a tile type at (x, y) with its registry footprint, numbering the
+// variants per its encoding; TILE_FLAG_OBJECT types are also recorded
+void room_place(Room *room, TileType type, int x, int y);
+
+// As room_place, for any area (rugs, floors, wall runs); sprite types
+// ignore w/h and use their footprint
+void room_place_area(Room *room, TileType type, int x, int y, int w, int h);
+
+bool room_has_dirty(const Room *room);
+
+// Collect dirty tiles as merged rectangles and clear them. Returns the
+// number of rects written; if more than max would be needed, a single
+// bounding rect is returned instead.
+int room_take_dirty(Room *room, TileRect *rects, int max);
+
+// Forget pending changes (after the whole room was redrawn)
+void room_clear_dirty(Room *room);
+
 #endif // ROOM_H
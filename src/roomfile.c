@@ -0,0 +1,293 @@
+/**
+ * roomfile.c - Binary room asset format (.room)
+ */
+
+#include "roomfile.h"
+#include "room.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef __EMSCRIPTEN__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define HEADER_SIZE 22
+#define OBJECT_SIZE 9
+#define ENTRY_SIZE 4
+
+// ----------------------------------------------------------------------------
+// Byte helpers
+// ----------------------------------------------------------------------------
+
+static uint8_t *put16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static uint8_t *put32(uint8_t *p, uint32_t v) {
+    return put16(put16(p, (uint16_t)v), (uint16_t)(v >> 16));
+}
+
+static uint16_t get16(const uint8_t *p) {
+    return (uint16_t)(p[0] | p[1] << 8);
+}
+
+static uint32_t get32(const uint8_t *p) {
+    return get16(p) | (uint32_t)get16(p + 2) << 16;
+}
+
+// ----------------------------------------------------------------------------
+// PackBits RLE: control byte c < 128 copies c+1 literal bytes, c >= 128
+// repeats the next byte c-126 times (2..129)
+// ----------------------------------------------------------------------------
+
+// Worst case output is n + n/128 + 1 bytes
+static size_t rle_encode(const uint8_t *in, size_t n, uint8_t *out) {
+    size_t o = 0, i = 0;
+    while (i < n) {
+        size_t run = 1;
+        while (i + run < n && run < 129 && in[i + run] == in[i]) run++;
+        if (run >= 2) {
+            out[o++] = (uint8_t)(run + 126);
+            out[o++] = in[i];
+            i += run;
+            continue;
+        }
+        // Literal: extend until the next run of 2 or more
+        size_t start = i++;
+        while (i < n && i - start < 128 && !(i + 1 < n && in[i] == in[i + 1])) i++;
+        out[o++] = (uint8_t)(i - start - 1);
+        memcpy(&out[o], &in[start], i - start);
+        o += i - start;
+    }
+    return o;
+}
+
+static bool rle_decode(const uint8_t *in, size_t n, uint8_t *out, size_t expected) {
+    size_t i = 0, o = 0;
+    while (i < n) {
+        uint8_t c = in[i++];
+        if (c < 128) {
+            size_t len = (size_t)c + 1;
+            if (i + len > n || o + len > expected) return false;
+            memcpy(&out[o], &in[i], len);
+            i += len;
+            o += len;
+        } else {
+            size_t len = (size_t)c - 126;
+            if (i >= n || o + len > expected) return false;
+            memset(&out[o], in[i++], len);
+            o += len;
+        }
+    }
+    return o == expected;
+}
+
+// ----------------------------------------------------------------------------
+// Variant prediction
+// ----------------------------------------------------------------------------
+
+static uint8_t predict(const uint8_t *variants, int width, int x, int y) {
+    if (x == 0 || y == 0) return 0;
+    return variants[(y - 1) * width + (x - 1)];
+}
+
+// ----------------------------------------------------------------------------
+// Encode / decode
+// ----------------------------------------------------------------------------
+
+uint8_t* roomfile_encode(const Room *room, size_t *size) {
+    size_t count = (size_t)room->width * room->height;
+    size_t layer_max = count + count / 128 + 1;
+    size_t capacity = HEADER_SIZE + room->object_count * OBJECT_SIZE +
+                      room->entry_count * ENTRY_SIZE + 2 * layer_max;
+    uint8_t *buf = malloc(capacity);
+    uint8_t *scratch = malloc(count * 3);
+    if (!buf || !scratch) {
+        free(buf);
+        free(scratch);
+        return NULL;
+    }
+
+    uint8_t *types = scratch, *variants = scratch + count, *deltas = scratch + 2 * count;
+    for (size_t i = 0; i < count; i++) {
+        types[i] = room->tiles[i].type;
+        variants[i] = room->tiles[i].variant;
+    }
+    for (int y = 0; y < room->height; y++) {
+        for (int x = 0; x < room->width; x++) {
+            int i = y * room->width + x;
+            deltas[i] = (uint8_t)(variants[i] - predict(variants, room->width, x, y));
+        }
+    }
+
+    uint8_t *p = buf + HEADER_SIZE;
+    for (int i = 0; i < room->object_count; i++) {
+        const RoomObject *obj = &room->objects[i];
+        *p++ = obj->type;
+        p = put16(p, obj->x);
+        p = put16(p, obj->y);
+        p = put16(p, obj->w);
+        p = put16(p, obj->h);
+    }
+    for (int i = 0; i < room->entry_count; i++) {
+        p = put16(p, room->entries[i].x);
+        p = put16(p, room->entries[i].y);
+    }
+    size_t type_size = rle_encode(types, count, p);
+    p += type_size;
+    size_t variant_size = rle_encode(deltas, count, p);
+    p += variant_size;
+    free(scratch);
+
+    uint8_t *h = buf;
+    memcpy(h, "ROOM", 4);
+    h = put16(h + 4, ROOMFILE_VERSION);
+    h = put16(h, (uint16_t)room->width);
+    h = put16(h, (uint16_t)room->height);
+    h = put16(h, (uint16_t)room->object_count);
+    h = put16(h, (uint16_t)room->entry_count);
+    h = put32(h, (uint32_t)type_size);
+    put32(h, (uint32_t)variant_size);
+
+    *size = (size_t)(p - buf);
+    return buf;
+}
+
+bool roomfile_decode(const uint8_t *data, size_t size, Room *room) {
+    if (size < HEADER_SIZE || memcmp(data, "ROOM", 4) != 0) return false;
+    if (get16(data + 4) != ROOMFILE_VERSION) return false;
+    int width = get16(data + 6), height = get16(data + 8);
+    if (width == 0 || height == 0 || width > ROOM_MAX_WIDTH || height > ROOM_MAX_HEIGHT) {
+        return false;
+    }
+
+    int object_count = get16(data + 10);
+    int entry_count = get16(data + 12);
+    size_t type_size = get32(data + 14);
+    size_t variant_size = get32(data + 18);
+    if (object_count > ROOM_MAX_OBJECTS || entry_count > ROOM_MAX_ENTRIES) return false;
+
+    // Term by term against what is left, so no sum can wrap (size_t is
+    // 32 bits on wasm32)
+    size_t tables = (size_t)object_count * OBJECT_SIZE + (size_t)entry_count * ENTRY_SIZE;
+    size_t left = size - HEADER_SIZE;
+    if (tables > left) return false;
+    left -= tables;
+    if (type_size > left) return false;
+    left -= type_size;
+    if (variant_size > left) return false;
+
+    const uint8_t *p = data + HEADER_SIZE;
+    for (int i = 0; i < object_count; i++, p += OBJECT_SIZE) {
+        RoomObject obj = {p[0], get16(p + 1), get16(p + 3), get16(p + 5), get16(p + 7)};
+        if (obj.type >= TILE_TYPE_COUNT) return false;
+        if (obj.x + obj.w > width || obj.y + obj.h > height) return false;
+        if (tile_is_sprite((TileType)obj.type) &&
+            (obj.w != TILE_INFO[obj.type].width || obj.h != TILE_INFO[obj.type].height)) {
+            return false;
+        }
+        room->objects[i] = obj;
+    }
+    room->object_count = object_count;
+    for (int i = 0; i < entry_count; i++, p += ENTRY_SIZE) {
+        RoomEntry entry = {get16(p), get16(p + 2)};
+        if (entry.x >= width || entry.y >= height) return false;
+        room->entries[i] = entry;
+    }
+    room->entry_count = entry_count;
+
+    size_t count = (size_t)width * height;
+    uint8_t *scratch = malloc(count * 2);
+    if (!scratch) return false;
+    uint8_t *types = scratch, *variants = scratch + count;
+    bool ok = rle_decode(p, type_size, types, count) &&
+              rle_decode(p + type_size, variant_size, variants, count);
+
+    // Undo the prediction in scan order so neighbours are already restored
+    for (int y = 0; y < height && ok; y++) {
+        for (int x = 0; x < width && ok; x++) {
+            int i = y * width + x;
+            variants[i] = (uint8_t)(variants[i] + predict(variants, width, x, y));
+            if (types[i] >= TILE_TYPE_COUNT) ok = false;
+            else if (tile_is_sprite((TileType)types[i])) {
+                // Must reference an object of the same type that covers it
+                if (variants[i] >= object_count) ok = false;
+                const RoomObject *obj = ok ? &room->objects[variants[i]] : NULL;
+                ok = ok && obj->type == types[i] && x >= obj->x && x < obj->x + obj->w &&
+                     y >= obj->y && y < obj->y + obj->h;
+            }
+        }
+    }
+
+    ok = ok && room_alloc(room, width, height);
+    if (ok) {
+        for (size_t i = 0; i < count; i++) room->storage[i] = (Tile){types[i], variants[i]};
+    }
+    free(scratch);
+    return ok;
+}
+
+// ----------------------------------------------------------------------------
+// Loading
+// ----------------------------------------------------------------------------
+
+#ifdef __EMSCRIPTEN__
+
+// Files come from the --preload-file package, already in MEMFS
+bool roomfile_load(const char *path, Room *room) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "roomfile: cannot open %s\n", path);
+        return false;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    uint8_t *data = size > 0 ? malloc((size_t)size) : NULL;
+    bool ok = data && fread(data, 1, (size_t)size, f) == (size_t)size &&
+              roomfile_decode(data, (size_t)size, room);
+    free(data);
+    fclose(f);
+
+    if (!ok) fprintf(stderr, "roomfile: %s is not a valid room\n", path);
+    return ok;
+}
+
+#else
+
+bool roomfile_load(const char *path, Room *room) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "roomfile: cannot open %s\n", path);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size <= 0) {
+        close(fd);
+        fprintf(stderr, "roomfile: %s is empty\n", path);
+        return false;
+    }
+
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        fprintf(stderr, "roomfile: cannot map %s\n", path);
+        return false;
+    }
+
+    bool ok = roomfile_decode(data, (size_t)st.st_size, room);
+    munmap(data, (size_t)st.st_size);
+
+    if (!ok) fprintf(stderr, "roomfile: %s is not a valid room\n", path);
+    return ok;
+}
+
+#endif
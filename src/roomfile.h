@@ -0,0 +1,40 @@
+/**
+ * roomfile.h - Binary room asset format (.room)
+ *
+ * Little-endian layout:
+ *
+ *   0   char[4]  magic "ROOM"
+ *   4   u16      version (ROOMFILE_VERSION)
+ *   6   u16      width, height (tiles)
+ *   10  u16      object count, entry count
+ *   14  u32      type layer size, variant layer size (bytes, compressed)
+ *   22  objects  { u8 type, u16 x, u16 y, u16 w, u16 h } each
+ *       entries  { u16 x, u16 y } each
+ *       type layer, then variant layer (PackBits RLE, row-major)
+ *
+ * Before compression each variant is stored as the difference from the
+ * variant of its upper-left neighbour: the floor checkerboard becomes
+ * zeros and row*W+col furniture becomes runs of W+1.
+ */
+
+#ifndef ROOMFILE_H
+#define ROOMFILE_H
+
+#include "world.h"
+#include <stddef.h>
+
+// 2: cells of sprite types hold their object index as the variant
+#define ROOMFILE_VERSION 2
+
+// Encode a room; returns a malloc'd buffer (caller frees) and its size,
+// or NULL on allocation failure
+uint8_t* roomfile_encode(const Room *room, size_t *size);
+
+// Decode into room (size, tiles, objects, entries); the tiles go into
+// newly allocated storage (room_alloc). False if malformed.
+bool roomfile_decode(const uint8_t *data, size_t size, Room *room);
+
+// Map (mmap natively, read from the preloaded FS on web) and decode a file
+bool roomfile_load(const char *path, Room *room);
+
+#endif // ROOMFILE_H
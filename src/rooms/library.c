@@ -0,0 +1,86 @@
+/**
+ * rooms/library.c - Library room layout
+ *
+ * Tall reading hall, a bit over one screen and a half, with two zones:
+ * - Stacks (y=2..55): wall shelves, two shelf aisles, reading nook
+ * - Studio (y=57..117): podcast corner, lounge, exit door back home
+ *
+ * An interior wall at y=56 separates the zones with a 4-tile doorway.
+ */
+
+#include "../room.h"
+
+// --- Placement helpers ---
+
+// Horizontal interior wall with a doorway gap
+static void place_interior_wall_h(Room *room, int y, int x_start, int x_end,
+                                   int door_x_start, int door_x_end) {
+    for (int x = x_start; x <= x_end; x++) {
+        if (x >= door_x_start && x <= door_x_end) continue;
+        room_set_tile(room, x, y, TILE_INTERIOR_WALL, 0);
+    }
+}
+
+// Column of bookshelves (12×2 each) with a walkable row between them
+static void place_shelf_aisle(Room *room, int x, int y, int count) {
+    for (int i = 0; i < count; i++) {
+        room_place(room, TILE_BOOKSHELF, x, y + i * 5);
+    }
+}
+
+void init_room_library(Room *room) {
+    int w = room->width, h = room->height;  // 50×120
+    room_place_area(room, TILE_FLOOR, 0, 0, w, h);
+
+    // === OUTER WALLS (2 tiles thick) ===
+    room_place_area(room, TILE_WALL, 0, 0, w, 2);
+    room_place_area(room, TILE_WALL, 0, h - 2, w, 2);
+    room_place_area(room, TILE_WALL, 0, 0, 2, h);
+    room_place_area(room, TILE_WALL, w - 2, 0, 2, h);
+
+    // === INTERIOR WALL ===
+    // Horizontal wall at y=56, x=2..47, doorway x=23..26
+    place_interior_wall_h(room, 56, 2, 47, 23, 26);
+
+    // === STACKS (y=2..55) ===
+    room_place(room, TILE_BOOKSHELF, 3, 2);           // Wall shelves along the top
+    room_place(room, TILE_BOOKSHELF, 19, 2);
+    room_place(room, TILE_BOOKSHELF, 35, 2);
+    place_shelf_aisle(room, 4, 10, 4);                // Left aisle: y=10..26
+    place_shelf_aisle(room, 34, 10, 4);               // Right aisle: y=10..26
+    room_place(room, TILE_PLANT, 23, 10);             // Plants at the aisle heads
+    room_place(room, TILE_PLANT, 25, 22);
+
+    // Reading nook
+    room_place_area(room, TILE_RUG, 14, 36, 22, 14);  // Reading rug: 22×14 at (14,36)
+    room_place(room, TILE_COUCH, 16, 44);             // Couch: 8×4 at (16,44)
+    room_place(room, TILE_COFFEE_TABLE, 18, 40);      // Coffee table: 4×2 at (18,40)
+    room_place(room, TILE_NIGHTSTAND, 26, 45);        // Lamp by the couch
+    room_place(room, TILE_BOOKSHELF, 3, 52);          // Shelves against the divider
+    room_place(room, TILE_BOOKSHELF, 35, 52);
+    room_place(room, TILE_PLANT, 3, 36);
+    room_place(room, TILE_PLANT, 45, 36);
+
+    // === STUDIO (y=57..117) ===
+    // Podcast corner
+    room_place_area(room, TILE_RUG, 30, 62, 16, 12);  // Studio rug: 16×12 at (30,62)
+    room_place(room, TILE_DESK, 35, 65);              // Desk: 6×3 at (35,65)
+    room_place(room, TILE_LAPTOP, 37, 65);            // Laptop: 2×2 at (37,65) overlaps desk
+    room_place(room, TILE_COUCH, 34, 70);             // Guest couch facing the desk
+    room_place(room, TILE_PLANT, 44, 59);
+    room_place(room, TILE_PLANT, 31, 59);
+
+    // Lounge
+    room_place(room, TILE_TV, 6, 60);                 // TV: 6×2 at (6,60)
+    room_place_area(room, TILE_RUG, 4, 66, 14, 10);   // Lounge rug: 14×10 at (4,66)
+    room_place(room, TILE_COFFEE_TABLE, 8, 68);
+    room_place(room, TILE_COUCH, 6, 72);
+    room_place(room, TILE_CATBED, 40, 100);           // Cat bed: 3×3 at (40,100)
+    room_place(room, TILE_BOOKSHELF, 3, 92);
+    room_place(room, TILE_PLANT, 3, 110);
+    room_place(room, TILE_PLANT, 45, 110);
+    room_place(room, TILE_DOOR, 24, 115);             // Door: 2×3 at (24,115)
+
+    // === ENTRY POINTS ===
+    room_add_entry(room, 24, 112);                    // Inside the exit door
+}
@@ -0,0 +1,185 @@
+/**
+ * stats.c - Per-frame performance counters and HUD overlay
+ */
+
+#include "stats.h"
+#include "cmdbuf.h"
+#include <string.h>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#else
+#define EMSCRIPTEN_KEEPALIVE
+#endif
+
+FrameStats g_frame_stats = {0};
+
+static StatsBuffer stats = { .capacity = STATS_HISTORY,
+                             .frame_words = sizeof(FrameStats) / 4 };
+static uint64_t mark_ticks = 0;
+static double ms_per_tick = 0.0;
+static bool overlay_visible = false;
+
+_Static_assert(sizeof(FrameStats) % 4 == 0, "FrameStats must be 32-bit words");
+
+// ----------------------------------------------------------------------------
+// Recording
+// ----------------------------------------------------------------------------
+
+void stats_begin_frame(void) {
+    if (ms_per_tick == 0.0) {
+        ms_per_tick = 1000.0 / (double)platform_tick_rate();
+    }
+    memset(&g_frame_stats, 0, sizeof(g_frame_stats));
+    mark_ticks = platform_ticks();
+}
+
+void stats_mark(StatsSection section) {
+    uint64_t now = platform_ticks();
+    g_frame_stats.ms[section] += (float)((now - mark_ticks) * ms_per_tick);
+    mark_ticks = now;
+}
+
+void stats_end_frame(void) {
+    stats.head = (stats.count == 0) ? 0 : (stats.head + 1) % STATS_HISTORY;
+    stats.frames[stats.head] = g_frame_stats;
+    stats.count++;
+}
+
+void stats_idle_frame(void) {
+    stats.idle_frames++;
+}
+
+EMSCRIPTEN_KEEPALIVE
+const StatsBuffer* stats_buffer(void) {
+    return &stats;
+}
+
+// ----------------------------------------------------------------------------
+// Overlay
+// ----------------------------------------------------------------------------
+
+#define HUD_X 8
+#define HUD_Y 8
+#define HUD_W 160
+#define HUD_GRAPH_H 40
+#define HUD_SCALE 2             // Font pixel size
+
+// 3x5 font: one byte per row, bit 2 = left column
+static const uint8_t FONT_DIGITS[10][5] = {
+    {7,5,5,5,7}, {2,6,2,2,7}, {7,1,7,4,7}, {7,1,7,1,7}, {5,5,7,1,1},
+    {7,4,7,1,7}, {7,4,7,5,7}, {7,1,1,1,1}, {7,5,7,5,7}, {7,5,7,1,7},
+};
+static const uint8_t FONT_LETTERS[26][5] = {
+    {7,5,7,5,5}, {6,5,6,5,6}, {7,4,4,4,7}, {6,5,5,5,6}, {7,4,6,4,7},
+    {7,4,6,4,4}, {7,4,5,5,7}, {5,5,7,5,5}, {7,2,2,2,7}, {1,1,1,5,7},
+    {5,5,6,5,5}, {4,4,4,4,7}, {5,7,7,5,5}, {6,5,5,5,5}, {7,5,5,5,7},
+    {7,5,7,4,4}, {7,5,5,7,1}, {6,5,6,5,5}, {7,4,7,1,7}, {7,2,2,2,2},
+    {5,5,5,5,7}, {5,5,5,5,2}, {5,5,7,7,5}, {5,5,2,5,5}, {5,5,7,2,2},
+    {7,1,2,4,7},
+};
+static const uint8_t FONT_DOT[5] = {0,0,0,0,2};
+
+static void hud_rect(CmdLayer layer, Color c, int x, int y, int w, int h) {
+    SDL_Rect r = {x, y, w, h};
+    cmd_fill(layer, c, 255, &r);
+}
+
+// Queue text (uppercase, digits, '.') at (x, y); returns the next line's y
+static int hud_text(int x, int y, const char *text) {
+    for (const char *p = text; *p; p++, x += 4 * HUD_SCALE) {
+        const uint8_t *glyph = NULL;
+        if (*p >= '0' && *p <= '9') glyph = FONT_DIGITS[*p - '0'];
+        else if (*p >= 'A' && *p <= 'Z') glyph = FONT_LETTERS[*p - 'A'];
+        else if (*p == '.') glyph = FONT_DOT;
+        if (!glyph) continue;
+        for (int row = 0; row < 5; row++)
+            for (int col = 0; col < 3; col++)
+                if (glyph[row] & (4 >> col))
+                    hud_rect(CMD_LAYER_UI, PALETTE[3], x + col * HUD_SCALE,
+                             y + row * HUD_SCALE, HUD_SCALE, HUD_SCALE);
+    }
+    return y + 6 * HUD_SCALE;
+}
+
+// Small integer/one-decimal formatting without pulling in printf
+static char *fmt_uint(char *out, uint32_t value) {
+    char digits[10];
+    int n = 0;
+    do { digits[n++] = (char)('0' + value % 10); value /= 10; } while (value);
+    while (n) *out++ = digits[--n];
+    *out = '\0';
+    return out;
+}
+
+static void fmt_line(char *out, const char *label, uint32_t value, int tenths) {
+    while (*label) *out++ = *label++;
+    *out++ = ' ';
+    if (tenths >= 0) {
+        out = fmt_uint(out, value);
+        *out++ = '.';
+        out = fmt_uint(out, (uint32_t)tenths);
+    } else {
+        fmt_uint(out, value);
+    }
+}
+
+void stats_toggle_overlay(void) {
+    overlay_visible = !overlay_visible;
+}
+
+bool stats_overlay_visible(void) {
+    return overlay_visible;
+}
+
+void stats_draw_overlay(void) {
+    if (stats.count == 0) return;
+
+    const FrameStats *last = &stats.frames[stats.head];
+    int samples = stats.count < HUD_W ? (int)stats.count : HUD_W;
+    float total = 0.0f;
+    for (int s = 0; s < STATS_SECTION_COUNT; s++) total += last->ms[s];
+
+    // Panel
+    int text_h = 6 * 6 * HUD_SCALE;
+    SDL_Rect panel = {HUD_X - 4, HUD_Y - 4, HUD_W + 8, text_h + HUD_GRAPH_H + 8};
+    cmd_fill(CMD_LAYER_UI_BACK, PALETTE[0], 220, &panel);
+
+    // Readouts for the most recent frame
+    char line[32];
+    int y = HUD_Y;
+    uint32_t tenths = (uint32_t)(total * 10.0f + 0.5f);
+    fmt_line(line, "MS", tenths / 10, (int)(tenths % 10));
+    y = hud_text(HUD_X, y, line);
+    fmt_line(line, "TILES", last->tiles, -1);
+    y = hud_text(HUD_X, y, line);
+    fmt_line(line, "CALLS", last->draw_calls, -1);
+    y = hud_text(HUD_X, y, line);
+    fmt_line(line, "COLORS", last->color_changes, -1);
+    y = hud_text(HUD_X, y, line);
+    fmt_line(line, "CHUNKS", last->chunks, -1);
+    y = hud_text(HUD_X, y, line);
+    fmt_line(line, "BAKED", last->chunk_bakes, -1);
+    y = hud_text(HUD_X, y, line);
+
+    // Frame time graph, newest on the right: 1px per ms, stacked by
+    // section (render bright, present mid, input+update dark)
+    int base = y + HUD_GRAPH_H;
+    static const uint8_t section_colors[STATS_SECTION_COUNT] = {1, 1, 3, 2};
+    for (int s = 0; s < STATS_SECTION_COUNT; s++) {
+        for (int i = 0; i < samples; i++) {
+            const FrameStats *f = &stats.frames[(stats.head + STATS_HISTORY - i) % STATS_HISTORY];
+            float below = 0.0f;
+            for (int k = 0; k < s; k++) below += f->ms[k];
+            int y0 = (int)below, y1 = (int)(below + f->ms[s] + 0.5f);
+            if (y1 > HUD_GRAPH_H) y1 = HUD_GRAPH_H;
+            if (y1 > y0) {
+                hud_rect(CMD_LAYER_UI, PALETTE[section_colors[s]],
+                         HUD_X + HUD_W - 1 - i, base - y1, 1, y1 - y0);
+            }
+        }
+    }
+
+    // 16.7ms (60Hz) budget line, over the graph
+    hud_rect(CMD_LAYER_UI_FRONT, PALETTE[2], HUD_X, base - 17, HUD_W, 1);
+}
@@ -0,0 +1,61 @@
+/**
+ * stats.h - Per-frame performance counters and HUD overlay
+ *
+ * The last STATS_HISTORY frames are kept in a ring buffer in wasm memory.
+ * shell.html reads it in place through the exported stats_buffer(); the
+ * layout is all 32-bit fields so JS can index it with HEAPU32/HEAPF32.
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include "game.h"
+
+#define STATS_HISTORY 256
+
+typedef enum {
+    STATS_INPUT = 0,    // handle_input()
+    STATS_UPDATE,       // update()
+    STATS_RENDER,       // render_frame()
+    STATS_PRESENT,      // render_present()
+    STATS_SECTION_COUNT
+} StatsSection;
+
+typedef struct {
+    float ms[STATS_SECTION_COUNT];  // Time per section
+    uint32_t tiles;                 // Tiles and object sprites drawn
+    uint32_t draw_calls;            // SDL draw/copy/upload calls
+    uint32_t color_changes;         // SDL_SetRenderDrawColor calls
+    uint32_t chunk_bakes;           // Room chunks rasterized from scratch
+    uint32_t chunks;                // Room chunks resident in the cache
+    uint32_t chunk_kb;              // Chunk cache size (CHUNK_CACHE_KB)
+} FrameStats;
+
+typedef struct {
+    uint32_t capacity;      // STATS_HISTORY
+    uint32_t frame_words;   // sizeof(FrameStats) / 4
+    uint32_t count;         // Frames recorded so far
+    uint32_t head;          // Slot of the most recent frame
+    uint32_t idle_frames;   // Frames skipped by the idle loop (not recorded)
+    FrameStats frames[STATS_HISTORY];
+} StatsBuffer;
+
+// Counters for the frame in progress (incremented by the render code)
+extern FrameStats g_frame_stats;
+
+void stats_begin_frame(void);
+// Charge the time since the previous mark to a section
+void stats_mark(StatsSection section);
+void stats_end_frame(void);
+// Count a frame that was skipped because nothing needed updating
+void stats_idle_frame(void);
+
+const StatsBuffer* stats_buffer(void);
+
+// HUD overlay (toggled with F3)
+void stats_toggle_overlay(void);
+bool stats_overlay_visible(void);
+// Records the HUD into the render command buffer (cmdbuf.h)
+void stats_draw_overlay(void);
+
+#endif // STATS_H
@@ -0,0 +1,81 @@
+/**
+ * tiles.h - Tile type registry and rasterizers
+ *
+ * Everything known about a TileType lives in one TILE_INFO entry: how it
+ * is drawn, its footprint, how its variants are numbered, and whether it
+ * blocks movement. Rendering, collision and placement all read it, so a
+ * new tile type is one table entry plus its draw function.
+ *
+ * Kept free of SDL so host tools (tools/roompack.c) can use it.
+ */
+
+#ifndef TILES_H
+#define TILES_H
+
+#include "world.h"
+
+// How a tile's variant is derived when it is placed (see room_place)
+typedef enum {
+    VARIANT_FIXED = 0,  // Always 0
+    VARIANT_PARITY,     // (x + y) % 2 in room coordinates (checkerboard)
+    VARIANT_GRID,       // row * width + col within the footprint; cells in a
+                        // room hold their RoomObject index instead (sprites)
+    VARIANT_EDGES,      // Edge flags: 1=top, 2=bottom, 4=left, 8=right
+} VariantEncoding;
+
+// TileInfo.flags
+#define TILE_FLAG_SOLID    0x01  // Blocks movement
+#define TILE_FLAG_INTERACT 0x02  // Has something to examine
+#define TILE_FLAG_OBJECT   0x04  // Placed as furniture (listed in Room.objects)
+#define TILE_FLAG_TALL     0x08  // Sprite whose top row does not collide, so
+                                 // actors can stand behind it (see room.c)
+
+// Rasterize one 8x8 tile at (px, py) of the current raster target
+typedef void (*TileDrawFn)(int px, int py, int variant);
+
+typedef struct {
+    const char *name;
+    TileDrawFn draw;
+    uint8_t width, height;  // Footprint in tiles; 0 = sized per placement
+    uint8_t encoding;       // VariantEncoding
+    uint8_t variants;       // Distinct variants the rasterizer draws
+    uint8_t flags;          // TILE_FLAG_*
+} TileInfo;
+
+extern const TileInfo TILE_INFO[TILE_TYPE_COUNT];
+
+static inline bool tile_is_solid(TileType type) {
+    return TILE_INFO[type].flags & TILE_FLAG_SOLID;
+}
+
+static inline bool tile_is_interactable(TileType type) {
+    return TILE_INFO[type].flags & TILE_FLAG_INTERACT;
+}
+
+// Fixed-footprint furniture, drawn as one whole-object sprite
+static inline bool tile_is_sprite(TileType type) {
+    return TILE_INFO[type].encoding == VARIANT_GRID;
+}
+
+// Characters are CHARACTER_SIZE square sprites with see-through pixels
+// (DESIGN.md: 16×16, 2×2 tiles)
+#define CHARACTER_SIZE 16
+
+// Rasterize the player character; opaque[i] is false where the sprite
+// shows what is underneath
+void character_rasterize(Color out[CHARACTER_SIZE * CHARACTER_SIZE],
+                         bool opaque[CHARACTER_SIZE * CHARACTER_SIZE]);
+
+// Primitive counters for the rasterizers (draw_pixel/fill_tile calls and
+// the pixels they wrote); only ever reset by tools such as bench/tile_bench.c
+typedef struct {
+    uint64_t calls;
+    uint64_t pixels;
+} RasterStats;
+
+extern RasterStats g_raster_stats;
+
+// Rasterize one tile into an 8x8 row-major bitmap (used to bake the atlas)
+void tile_rasterize(TileType type, int variant, Color out[TILE_SIZE * TILE_SIZE]);
+
+#endif // TILES_H
@@ -0,0 +1,108 @@
+/**
+ * world.h - Tile and room data types
+ *
+ * Kept free of SDL so host tools (tools/roompack.c) can build rooms.
+ */
+
+#ifndef WORLD_H
+#define WORLD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Window dimensions (portrait, mobile-friendly)
+#define WINDOW_WIDTH 400
+#define WINDOW_HEIGHT 640
+
+// Tile system; the grid is what fits on screen, rooms may be larger
+#define TILE_SIZE 8
+#define GRID_WIDTH (WINDOW_WIDTH / TILE_SIZE)   // 50 tiles
+#define GRID_HEIGHT (WINDOW_HEIGHT / TILE_SIZE) // 80 tiles
+
+// ----------------------------------------------------------------------------
+// Types
+// ----------------------------------------------------------------------------
+
+typedef struct { uint8_t r, g, b; } Color;
+
+// Game Boy palette (DESIGN.md; defined in tiles.c)
+extern const Color PALETTE[4];
+
+typedef enum {
+    TILE_FLOOR = 0,     // Walkable
+    TILE_WALL,          // Solid, blocks movement
+    TILE_DOOR,          // Room transition
+    TILE_COUCH,         // Couch furniture
+    TILE_DESK,          // Desk furniture
+    TILE_LAPTOP,        // Laptop on desk
+    TILE_BOOKSHELF,     // Bookshelf furniture
+    TILE_RUG,           // Rug (non-solid)
+    TILE_TV,            // Television
+    TILE_COFFEE_TABLE,  // Coffee table
+    TILE_COUNTER,       // Kitchen counter
+    TILE_FRIDGE,        // Refrigerator
+    TILE_CATBED,        // Cat bed (non-solid)
+    TILE_PLANT,         // Potted plant
+    TILE_BED,           // Bed furniture
+    TILE_NIGHTSTAND,    // Nightstand with lamp
+    TILE_INTERIOR_WALL, // Interior divider wall
+    TILE_TYPE_COUNT     // Number of tile types (not a tile)
+} TileType;
+
+// Variant encodes position within a multi-tile object; how it is numbered
+// for each type is given by TILE_INFO[type].encoding (tiles.h)
+
+// Packed to 2 bytes so a room's grid is 8KB; read and write tiles through
+// room_tile()/room_set_tile() (room.h) rather than indexing Room.tiles
+typedef struct {
+    uint8_t type;       // TileType
+    uint8_t variant;    // Visual variant, or RoomObject index for sprite
+                        // types (see room_tile_variant)
+} Tile;
+
+_Static_assert(sizeof(Tile) == 2, "Tile must stay packed");
+_Static_assert(TILE_TYPE_COUNT <= 256, "TileType must fit in Tile.type");
+
+// Furniture placed as one unit (tile units; see room_place). Sprite types
+// are drawn from this list in order, later objects covering earlier ones.
+typedef struct {
+    uint8_t type;       // TileType
+    uint16_t x, y;      // Top-left tile
+    uint16_t w, h;      // Footprint in tiles
+} RoomObject;
+
+// Where the player can appear when entering the room (tile units)
+typedef struct {
+    uint16_t x, y;
+} RoomEntry;
+
+#define ROOM_MAX_OBJECTS 64
+#define ROOM_MAX_ENTRIES 8
+
+// Rooms can be larger than the screen (the camera scrolls)
+#define ROOM_MAX_WIDTH 256
+#define ROOM_MAX_HEIGHT 256
+
+typedef struct {
+    // Row-major height rows × width cols: either baked read-only data or
+    // storage. room_set_tile() copies baked tiles into storage on first write.
+    const Tile *tiles;
+    Tile *storage;                // malloc'd, width * height; NULL until needed
+    int width, height;            // In tiles
+    const char *name;
+    uint32_t serial;              // Changes on every load, for caches keyed by Room*
+    // Bitsets of height rows × row_words 64-bit words, in one malloc'd
+    // block sized to the room (see room_alloc)
+    uint64_t *dirty;              // Bit x = tile changed since last draw
+    uint64_t *solid;              // Bit x = tile blocks movement
+    int row_words;
+    RoomObject objects[ROOM_MAX_OBJECTS];
+    int object_count;
+    RoomEntry entries[ROOM_MAX_ENTRIES];
+    int entry_count;
+} Room;
+
+// Rectangle in tile units
+typedef struct { int x, y, w, h; } TileRect;
+
+#endif // WORLD_H
@@ -0,0 +1,56 @@
+/**
+ * pool_test.c - Worker pool restarts and job boundaries (make test)
+ *
+ * Built with POOL_CORES so the workers start on any machine. Restarts the
+ * pool the way a device reset does (render_shutdown, then render_init)
+ * and checks that every job runs each item exactly once and that no item
+ * is still running, or runs again, after pool_run() returns.
+ */
+
+#include "pool.h"
+#include <stdatomic.h>
+#include <stdio.h>
+
+#define RESTARTS 500
+#define JOBS 20
+#define MAX_ITEMS 64
+
+static atomic_int runs[MAX_ITEMS];
+static atomic_int running;
+
+static void item(void *ctx, int index) {
+    (void)ctx;
+    atomic_fetch_add(&running, 1);
+    // Long enough for the threads to overlap
+    volatile unsigned spin = 0;
+    for (int i = 0; i < 200 + index * 37 % 500; i++) spin += (unsigned)i;
+    atomic_fetch_add(&runs[index], 1);
+    atomic_fetch_sub(&running, 1);
+}
+
+int main(void) {
+    int failures = 0;
+    for (int restart = 0; restart < RESTARTS && !failures; restart++) {
+        pool_init();
+        for (int job = 0; job < JOBS && !failures; job++) {
+            int count = 2 + (restart * JOBS + job) % (MAX_ITEMS - 1);
+            for (int i = 0; i < MAX_ITEMS; i++) atomic_store(&runs[i], 0);
+            pool_run(count, item, NULL);
+            if (atomic_load(&running) != 0) {
+                fprintf(stderr, "restart %d job %d: returned with items running\n", restart, job);
+                failures++;
+            }
+            for (int i = 0; i < MAX_ITEMS; i++) {
+                int expected = i < count ? 1 : 0;
+                if (atomic_load(&runs[i]) != expected) {
+                    fprintf(stderr, "restart %d job %d: item %d ran %d times\n",
+                            restart, job, i, atomic_load(&runs[i]));
+                    failures++;
+                }
+            }
+        }
+        pool_shutdown();
+    }
+    printf("pool: %d restarts x %d jobs, %s\n", RESTARTS, JOBS, failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}
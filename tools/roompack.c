@@ -0,0 +1,160 @@
+/**
+ * roompack.c - Bake rooms into .room assets and const tables (host tool)
+ *
+ * Runs every room builder in src/rooms/ and writes the encoded room to
+ * <out-dir>/<asset>. Resident rooms are also emitted into <tables.c> as
+ * static const arrays, so the game links them into read-only data instead
+ * of building or decoding them at startup. Built by the Makefile with the
+ * host compiler; needs no SDL.
+ *
+ * Usage: roompack <out-dir> <tables.c>
+ */
+
+#include "room.h"
+#include "roomfile.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// C identifier prefix from the asset name ("home.room" -> "home")
+static void table_prefix(RoomId id, char *out, size_t size) {
+    const char *asset = room_asset_name(id);
+    size_t n = 0;
+    for (; asset[n] && asset[n] != '.' && n + 1 < size; n++) {
+        char c = asset[n];
+        out[n] = (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') ? c : '_';
+    }
+    out[n] = '\0';
+}
+
+// What BAKED_ROOMS needs of each room written by write_tables(), kept so
+// the index does not build the rooms again
+typedef struct {
+    bool written;
+    int width, height;
+    int object_count, entry_count;
+} TableIndex;
+
+static TableIndex table_index[ROOM_COUNT];
+
+static void write_tables(FILE *f, RoomId id, const Room *room) {
+    char prefix[64];
+    table_prefix(id, prefix, sizeof(prefix));
+    table_index[id] = (TableIndex){true, room->width, room->height,
+                                   room->object_count, room->entry_count};
+
+    fprintf(f, "// %s\n", room->name);
+    fprintf(f, "static const Tile %s_tiles[%d * %d] = {\n", prefix, room->height, room->width);
+    for (int y = 0; y < room->height; y++) {
+        fprintf(f, "   ");
+        for (int x = 0; x < room->width; x++) {
+            const Tile *t = room_tile(room, x, y);
+            fprintf(f, " {%d,%d},", t->type, t->variant);
+        }
+        fprintf(f, "\n");
+    }
+    fprintf(f, "};\n");
+
+    if (room->object_count > 0) {
+        fprintf(f, "static const RoomObject %s_objects[] = {\n", prefix);
+        for (int i = 0; i < room->object_count; i++) {
+            const RoomObject *o = &room->objects[i];
+            fprintf(f, "    {%d, %d, %d, %d, %d},\n", o->type, o->x, o->y, o->w, o->h);
+        }
+        fprintf(f, "};\n");
+    }
+    if (room->entry_count > 0) {
+        fprintf(f, "static const RoomEntry %s_entries[] = {\n", prefix);
+        for (int i = 0; i < room->entry_count; i++) {
+            fprintf(f, "    {%d, %d},\n", room->entries[i].x, room->entries[i].y);
+        }
+        fprintf(f, "};\n");
+    }
+    fprintf(f, "\n");
+}
+
+static void write_table_index(FILE *f) {
+    fprintf(f, "const BakedRoom BAKED_ROOMS[ROOM_COUNT] = {\n");
+    for (int id = 0; id < ROOM_COUNT; id++) {
+        const TableIndex *t = &table_index[id];
+        if (!t->written) continue;
+        char prefix[64];
+        table_prefix((RoomId)id, prefix, sizeof(prefix));
+        fprintf(f, "    [%d] = { %s_tiles, %d, %d, ", id, prefix, t->width, t->height);
+        if (t->object_count > 0) fprintf(f, "%s_objects, %d, ", prefix, t->object_count);
+        else fprintf(f, "NULL, 0, ");
+        if (t->entry_count > 0) fprintf(f, "%s_entries, %d },\n", prefix, t->entry_count);
+        else fprintf(f, "NULL, 0 },\n");
+    }
+    fprintf(f, "};\n");
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <out-dir> <tables.c>\n", argv[0]);
+        return 1;
+    }
+
+    FILE *tables = fopen(argv[2], "w");
+    if (!tables) {
+        fprintf(stderr, "roompack: cannot write %s\n", argv[2]);
+        return 1;
+    }
+    fprintf(tables, "// Generated by tools/roompack.c from src/rooms/ - do not edit\n\n");
+    fprintf(tables, "#include \"room.h\"\n#include <stddef.h>\n\n");
+
+    static Room room;
+    for (int id = 0; id < ROOM_COUNT; id++) {
+        room_build((RoomId)id, &room);
+        if (!room.tiles) {
+            fclose(tables);
+            return 1;
+        }
+        size_t raw = (size_t)room.width * room.height * sizeof(Tile);
+
+        size_t size;
+        uint8_t *data = roomfile_encode(&room, &size);
+        if (!data) {
+            fprintf(stderr, "roompack: out of memory\n");
+            fclose(tables);
+            return 1;
+        }
+
+        // Round-trip check so a bad encoder never ships
+        static Room check;
+        bool same = roomfile_decode(data, size, &check) && check.width == room.width &&
+                    check.height == room.height && memcmp(check.tiles, room.tiles, raw) == 0;
+        room_free(&check);
+        if (!same) {
+            fprintf(stderr, "roompack: %s does not round-trip\n", room.name);
+            free(data);
+            fclose(tables);
+            return 1;
+        }
+
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", argv[1], room_asset_name((RoomId)id));
+        FILE *f = fopen(path, "wb");
+        if (!f || fwrite(data, 1, size, f) != size) {
+            fprintf(stderr, "roompack: cannot write %s\n", path);
+            if (f) fclose(f);
+            free(data);
+            fclose(tables);
+            return 1;
+        }
+        fclose(f);
+        free(data);
+
+        if (room_is_resident((RoomId)id)) write_tables(tables, (RoomId)id, &room);
+        printf("%s: %zu bytes (%dx%d, %zu bytes of raw tiles)%s\n", path, size,
+               room.width, room.height, raw, room_is_resident((RoomId)id) ? ", resident" : "");
+        room_free(&room);
+    }
+
+    write_table_index(tables);
+    if (fclose(tables) != 0) {
+        fprintf(stderr, "roompack: cannot write %s\n", argv[2]);
+        return 1;
+    }
+    return 0;
+}
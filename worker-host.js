@@ -0,0 +1,100 @@
+// worker-host.js - Page side of the worker build (make PLATFORM=worker)
+//
+// The game runs in a dedicated worker (worker.js) that owns the canvas as
+// an OffscreenCanvas, so page scrolling, layout and the scanline overlay
+// no longer share a thread with main_loop(). The page only forwards key
+// changes, through a ring buffer the game drains once per frame (layout
+// in src/platform_html5.c), and asks the worker for wasmStats(). When the page is cross-origin isolated
+// (COOP/COEP headers) the ring is shared memory; otherwise the entries go
+// by postMessage and worker.js writes them into its own copy of the ring.
+(function () {
+    var RING_SIZE = 64;
+    var KEY_DOWN = 1, KEY_UP = 2, RELEASE_ALL = 3, EVENT = 4;
+
+    // KeyboardEvent.code to INPUT_* (src/platform.h)
+    var KEYS = {
+        ArrowLeft: 1, KeyA: 1,
+        ArrowRight: 2, KeyD: 2,
+        ArrowUp: 4, KeyW: 4,
+        ArrowDown: 8, KeyS: 8
+    };
+
+    // KeyboardEvent.code to EVENT_* (src/platform.h), sent on keydown
+    var EVENTS = {
+        Escape: 2,
+        F3: 4
+    };
+
+    var canvas = document.getElementById('canvas');
+    if (!canvas.transferControlToOffscreen) {
+        document.getElementById('loading').textContent = 'This build needs OffscreenCanvas.';
+        return;
+    }
+    var offscreen = canvas.transferControlToOffscreen();
+    var shared = typeof SharedArrayBuffer === 'function' && self.crossOriginIsolated;
+    var ring = shared ? new Int32Array(new SharedArrayBuffer((2 + RING_SIZE) * 4)) : null;
+
+    var worker = new Worker('worker.js');
+    worker.postMessage({ canvas: offscreen, ring: ring && ring.buffer }, [offscreen]);
+    var statsWaiting = [];
+    worker.onmessage = function (e) {
+        if (e.data === 'ready') {
+            document.getElementById('loading').classList.add('hidden');
+            console.log('WASM initialized (worker)');
+        } else if (e.data.stats !== undefined) {
+            var buffer = e.data.stats;
+            var stats = buffer && statsFrom(new Uint32Array(buffer), new Float32Array(buffer), 0);
+            statsWaiting.splice(0).forEach(function (resolve) {
+                resolve(stats);
+            });
+        }
+    };
+
+    // The stats ring is in the worker's memory: wasmStats() (shell.html)
+    // asks for a copy and resolves with the same object once it arrives
+    window.wasmStats = function () {
+        return new Promise(function (resolve) {
+            if (statsWaiting.push(resolve) === 1) worker.postMessage({ stats: true });
+        });
+    };
+
+    // A full ring means the game has stalled; dropping keeps the page free
+    function send(entry) {
+        if (!ring) {
+            worker.postMessage({ input: entry });
+            return;
+        }
+        var written = Atomics.load(ring, 0);
+        if (((written - Atomics.load(ring, 1)) | 0) >= RING_SIZE) return;
+        Atomics.store(ring, 2 + (written & (RING_SIZE - 1)), entry);
+        Atomics.store(ring, 0, (written + 1) | 0);
+    }
+
+    // Movement keys are consumed so the arrows do not scroll the page, and
+    // F3 so it does not open the find bar; Escape still reaches the browser
+    function onKey(kind) {
+        return function (e) {
+            var event = EVENTS[e.code];
+            if (event) {
+                if (e.code !== 'Escape') e.preventDefault();
+                if (kind === KEY_DOWN && !e.repeat) send(EVENT << 8 | event);
+                return;
+            }
+            var bits = KEYS[e.code];
+            if (!bits) return;
+            e.preventDefault();
+            if (!e.repeat) send(kind << 8 | bits);
+        };
+    }
+    window.addEventListener('keydown', onKey(KEY_DOWN));
+    window.addEventListener('keyup', onKey(KEY_UP));
+
+    // Keys released while the page is in the background never send keyup,
+    // and a hidden tab does not always lose focus first
+    window.addEventListener('blur', function () {
+        send(RELEASE_ALL << 8);
+    });
+    document.addEventListener('visibilitychange', function () {
+        if (document.hidden) send(RELEASE_ALL << 8);
+    });
+})();
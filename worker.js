@@ -0,0 +1,52 @@
+// worker.js - Worker side of the worker build (make PLATFORM=worker)
+//
+// Waits for the canvas and input ring from worker-host.js, then loads the
+// game, whose main loop runs on this thread from then on. Also answers the
+// page's stats requests.
+var RING_SIZE = 64;
+
+onmessage = function (e) {
+    var ring = self.Module && self.Module.inputRing;
+
+    // wasmStats() on the page: a copy of the stats ring (src/stats.h), or
+    // null before the game is up
+    if (e.data.stats) {
+        if (!self.Module.ready) {
+            postMessage({ stats: null });
+            return;
+        }
+        var base = Module.ccall('stats_buffer', 'number', [], []) >> 2;
+        var u32 = Module.HEAPU32;
+        var copy = u32.slice(base, base + 5 + u32[base] * u32[base + 1]);
+        postMessage({ stats: copy.buffer }, [copy.buffer]);
+        return;
+    }
+
+    // No shared memory: the page posts each entry instead (worker-host.js)
+    if (e.data.input !== undefined) {
+        var written = ring[0];
+        if (((written - ring[1]) | 0) < RING_SIZE) {
+            ring[2 + (written & (RING_SIZE - 1))] = e.data.input;
+            ring[0] = (written + 1) | 0;
+        }
+        return;
+    }
+
+    self.Module = {
+        canvas: e.data.canvas,
+        // Threaded builds start their pool's workers from this script
+        mainScriptUrlOrBlob: 'game.js',
+        inputRing: new Int32Array(e.data.ring || new ArrayBuffer((2 + RING_SIZE) * 4)),
+        onRuntimeInitialized: function () {
+            self.Module.ready = true;
+            postMessage('ready');
+        },
+        print: function (text) {
+            console.log(text);
+        },
+        printErr: function (text) {
+            console.error(text);
+        }
+    };
+    importScripts('game.js');
+};